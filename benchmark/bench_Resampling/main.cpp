@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <BayesFilters/MetropolisResampling.h>
+#include <BayesFilters/MultinomialResampling.h>
+#include <BayesFilters/RejectionResampling.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/ResidualResampling.h>
+#include <BayesFilters/StratifiedResampling.h>
+#include <BayesFilters/ThreadPool.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/*
+ * Usage: bench_Resampling [num_threads]
+ *
+ * For each resampling scheme and number of particles, reports the ancestor
+ * throughput and the variance of the number of offspring with respect to its
+ * expected value M * w_i, averaged over the particles.
+ */
+int main(int argc, char* argv[])
+{
+    const unsigned int num_threads = argc > 1 ? std::atoi(argv[1]) : 1;
+
+    std::shared_ptr<ThreadPool> thread_pool;
+    if (num_threads != 1)
+        thread_pool = std::make_shared<ThreadPool>(num_threads);
+
+
+    std::vector<std::pair<std::string, std::unique_ptr<Resampling>>> schemes;
+    schemes.emplace_back("systematic",  std::unique_ptr<Resampling>(new Resampling(1)));
+    schemes.emplace_back("multinomial", std::unique_ptr<Resampling>(new MultinomialResampling(1)));
+    schemes.emplace_back("stratified",  std::unique_ptr<Resampling>(new StratifiedResampling(1)));
+    schemes.emplace_back("residual",    std::unique_ptr<Resampling>(new ResidualResampling(1)));
+    schemes.emplace_back("metropolis",  std::unique_ptr<Resampling>(new MetropolisResampling(1)));
+    schemes.emplace_back("rejection",   std::unique_ptr<Resampling>(new RejectionResampling(1)));
+
+    std::cout << std::setw(12) << "scheme" << std::setw(12) << "particles"
+              << std::setw(16) << "Mparticles/s" << std::setw(16) << "offspring var" << std::endl;
+
+    for (std::size_t num_particles = 1000; num_particles <= 10000000; num_particles *= 10)
+    {
+        VectorXf weights = VectorXf::Random(num_particles).array().abs() + 0.01f;
+
+        const VectorXd expected = num_particles * weights.cast<double>() / weights.cast<double>().sum();
+
+        VectorXl ancestors(num_particles);
+        VectorXd counts(num_particles);
+
+        const std::size_t num_repetitions = std::max<std::size_t>(1, 10000000 / num_particles);
+
+        for (auto& scheme : schemes)
+        {
+            scheme.second->setThreadPool(thread_pool);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (std::size_t n = 0; n < num_repetitions; ++n)
+                scheme.second->ancestors(weights, ancestors);
+
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            counts.setZero();
+            for (std::size_t j = 0; j < num_particles; ++j)
+                counts(ancestors(j)) += 1.0;
+
+            std::cout << std::setw(12) << scheme.first
+                      << std::setw(12) << num_particles
+                      << std::setw(16) << num_repetitions * num_particles / elapsed / 1e6
+                      << std::setw(16) << (counts - expected).squaredNorm() / num_particles << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#ifndef APF_H
+#define APF_H
+
+#include "AuxiliaryFunction.h"
+#include "SIS.h"
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class APF;
+}
+
+
+/**
+ * Auxiliary particle filter. Before the prediction, the particles are
+ * resampled according to first-stage weights, i.e. their weights times the
+ * look-ahead adjustment of an AuxiliaryFunction, then the selected particles
+ * are propagated by the prediction, and the correction multiplies the
+ * second-stage weights, i.e. the inverse of the adjustment of their
+ * ancestors, by the likelihood.
+ *
+ * Prediction, correction and resampling are set as for SIS. The resampling
+ * algorithm is used by the first stage at every step, which also applies the
+ * number of particles set by setNumParticles() or KLD-sampling, while the
+ * resampling policy is not used.
+ */
+class bfl::APF : public SIS
+{
+public:
+    APF() noexcept;
+
+    APF(APF&& apf) noexcept;
+
+    virtual ~APF() noexcept;
+
+    APF& operator=(APF&& apf) noexcept;
+
+    void setAuxiliaryFunction(std::unique_ptr<AuxiliaryFunction> auxiliary_function);
+
+    void filteringStep() override;
+
+protected:
+    std::unique_ptr<AuxiliaryFunction> auxiliary_function_;
+
+private:
+    Eigen::VectorXf                    aux_log_weights_;
+    Eigen::VectorXf                    res_aux_log_weights_;
+    Eigen::VectorXf                    first_stage_weights_;
+    VectorXl                           ancestors_;
+};
+
+#endif /* APF_H */
@@ -1,4 +1,47 @@
 #ifndef AUXILIARYFUNCTION_H
 #define AUXILIARYFUNCTION_H
 
+#include "PFCorrection.h"
+#include "PFPrediction.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class AuxiliaryFunction;
+}
+
+
+/**
+ * First-stage weighting of the auxiliary particle filter, i.e. the
+ * look-ahead that favours the particles likely to explain the upcoming
+ * measurement before they are resampled and propagated.
+ */
+class bfl::AuxiliaryFunction
+{
+public:
+    AuxiliaryFunction() noexcept;
+
+    AuxiliaryFunction(AuxiliaryFunction&& auxiliary_function) noexcept;
+
+    virtual ~AuxiliaryFunction() noexcept;
+
+    AuxiliaryFunction& operator=(AuxiliaryFunction&& auxiliary_function) noexcept;
+
+    /**
+     * Write in log_weights the log of the first-stage weight adjustment of
+     * each particle of prev_states given the upcoming measurement.
+     * By default this is log p(z_k | f(x_k-1)), the log-likelihood of the
+     * measurement at the point estimate given by the noise-free propagation
+     * of the state model of prediction, evaluated by correction.
+     */
+    virtual void logWeights(PFPrediction& prediction, PFCorrection& correction,
+                            const Eigen::Ref<const Eigen::MatrixXf>& prev_states, const Eigen::Ref<const Eigen::MatrixXf>& measurements,
+                            Eigen::Ref<Eigen::VectorXf> log_weights);
+
+protected:
+    Eigen::MatrixXf point_estimates_;
+
+    Eigen::MatrixXf innovations_;
+};
+
 #endif /* AUXILIARYFUNCTION_H */
@@ -0,0 +1,137 @@
+#ifndef BATCHKALMANFILTER_H
+#define BATCHKALMANFILTER_H
+
+#include "ObservationModel.h"
+#include "StateModel.h"
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class BatchKalmanFilter;
+}
+
+
+/**
+ * Kalman filter running many independent tracks that share the same linear
+ * Gaussian model. Track data are stored as structure of arrays: means are a
+ * (tracks x n) matrix and covariances a (tracks x n^2) matrix, where column
+ * i + n * j holds the (i, j) entry of every track. Predict and update then
+ * sweep all the tracks at once with column operations and small matrix
+ * products, and the 2x2, 3x3, ... innovation covariances are factorized
+ * column-wise across tracks.
+ */
+class bfl::BatchKalmanFilter
+{
+public:
+    BatchKalmanFilter(std::unique_ptr<StateModel> state_model, const Eigen::Ref<const Eigen::MatrixXf>& F,
+                      std::unique_ptr<ObservationModel> observation_model, const Eigen::Ref<const Eigen::MatrixXf>& H) noexcept;
+
+    BatchKalmanFilter(BatchKalmanFilter&& batch_kf) noexcept;
+
+    virtual ~BatchKalmanFilter() noexcept;
+
+    BatchKalmanFilter& operator=(BatchKalmanFilter&& batch_kf) noexcept;
+
+    /**
+     * Set the tracks: column t of means is the mean of track t and column t
+     * of covariances is its column-major vectorized covariance matrix.
+     */
+    void initialize(const Eigen::Ref<const Eigen::MatrixXf>& means, const Eigen::Ref<const Eigen::MatrixXf>& covariances);
+
+    void predict();
+
+    /**
+     * Update every track with the measurement in the corresponding column of
+     * measurements.
+     */
+    void correct(const Eigen::Ref<const Eigen::MatrixXf>& measurements);
+
+    /**
+     * Update only the tracks t such that mask(t) is true, the others keep
+     * their predicted mean and covariance.
+     */
+    void correct(const Eigen::Ref<const Eigen::MatrixXf>& measurements, const Eigen::Ref<const Eigen::Array<bool, Eigen::Dynamic, 1>>& mask);
+
+    std::size_t getNumTracks() const;
+
+    /**
+     * Means in structure of arrays layout, i.e. a (tracks x n) matrix.
+     */
+    const Eigen::MatrixXf& getMeans() const;
+
+    /**
+     * Covariances in structure of arrays layout, i.e. a (tracks x n^2) matrix.
+     */
+    const Eigen::MatrixXf& getCovariances() const;
+
+    Eigen::VectorXf getMean(const std::size_t track) const;
+
+    Eigen::MatrixXf getCovariance(const std::size_t track) const;
+
+    StateModel& getStateModel();
+
+    ObservationModel& getObservationModel();
+
+    /**
+     * Kronecker product of A and B. With column-major vectorization,
+     * vec(A X B') = (B kron A) vec(X).
+     */
+    static Eigen::MatrixXf kronecker(const Eigen::Ref<const Eigen::MatrixXf>& A, const Eigen::Ref<const Eigen::MatrixXf>& B);
+
+    /**
+     * Cholesky factorization S = L L' of the m x m matrices stored in
+     * structure of arrays layout in S, done in place. Only the columns of the
+     * lower triangular part are overwritten by L.
+     */
+    static void choleskyColumns(Eigen::Ref<Eigen::MatrixXf> S, const int m);
+
+    /**
+     * Solve L v = x in place for the m-vectors stored as rows of x, given the
+     * factors L computed by choleskyColumns().
+     */
+    static void lowerSolveColumns(const Eigen::Ref<const Eigen::MatrixXf>& L, const int m, Eigen::Ref<Eigen::MatrixXf> x);
+
+    /**
+     * Compute X S^-1 in place for the n x m matrices stored in structure of
+     * arrays layout in X, given the factors of S computed by choleskyColumns().
+     */
+    static void rightSolveColumns(const Eigen::Ref<const Eigen::MatrixXf>& L, const int m, Eigen::Ref<Eigen::MatrixXf> X, const int n);
+
+protected:
+    /**
+     * Refresh the noise covariances and the Kronecker products used to
+     * propagate vectorized covariances.
+     */
+    void cacheModelMatrices();
+
+    void correctTracks(const Eigen::Ref<const Eigen::MatrixXf>& measurements, const Eigen::Ref<const Eigen::ArrayXf>& mask);
+
+    std::unique_ptr<StateModel>       state_model_;
+    std::unique_ptr<ObservationModel> observation_model_;
+
+    Eigen::MatrixXf                   F_;
+    Eigen::MatrixXf                   H_;
+
+    Eigen::RowVectorXf                Q_;          /* Vectorized process noise covariance */
+    Eigen::RowVectorXf                R_;          /* Vectorized measurement noise covariance */
+    Eigen::MatrixXf                   FF_t_;       /* (F kron F)' */
+    Eigen::MatrixXf                   HH_t_;       /* (H kron H)' */
+    Eigen::MatrixXf                   HI_t_;       /* (H kron I)' */
+
+    Eigen::MatrixXf                   means_;
+    Eigen::MatrixXf                   covariances_;
+
+private:
+    /* Workspaces, in structure of arrays layout */
+    Eigen::MatrixXf                   means_tmp_;
+    Eigen::MatrixXf                   covariances_tmp_;
+    Eigen::MatrixXf                   innovations_;
+    Eigen::MatrixXf                   S_;
+    Eigen::MatrixXf                   PHt_;
+    Eigen::MatrixXf                   K_;
+    Eigen::ArrayXf                    mask_;
+};
+
+#endif /* BATCHKALMANFILTER_H */
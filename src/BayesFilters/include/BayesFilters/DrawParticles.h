@@ -3,8 +3,9 @@
 
 #include "PFPrediction.h"
 
-#include <random>
+#include <cstdint>
 #include <memory>
+#include <random>
 
 namespace bfl {
     class DrawParticles;
@@ -24,11 +25,16 @@ public:
 
     virtual void setStateModel(std::unique_ptr<StateModel> state_model) override;
 
+    void resetNoise() override;
+
 protected:
     void predictStep(const Eigen::Ref<const Eigen::MatrixXf>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
                      Eigen::Ref<Eigen::MatrixXf> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) override;
 
     std::unique_ptr<StateModel> state_model_;
+
+    /* Key of the noise drawn by the state model, incremented at every prediction. */
+    std::uint64_t               noise_step_ = 0;
 };
 
 #endif /* DRAWPARTICLES_H */
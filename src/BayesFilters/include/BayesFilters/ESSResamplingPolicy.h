@@ -0,0 +1,30 @@
+#ifndef ESSRESAMPLINGPOLICY_H
+#define ESSRESAMPLINGPOLICY_H
+
+#include "ResamplingPolicy.h"
+
+namespace bfl {
+    class ESSResamplingPolicy;
+}
+
+
+/**
+ * Resample when the effective sample size falls below ratio times the
+ * number of particles.
+ */
+class bfl::ESSResamplingPolicy : public ResamplingPolicy
+{
+public:
+    ESSResamplingPolicy(double ratio) noexcept;
+
+    ESSResamplingPolicy() noexcept;
+
+    virtual ~ESSResamplingPolicy() noexcept;
+
+    bool resample(const WeightStatistics& statistics, const unsigned int step) override;
+
+protected:
+    double ratio_;
+};
+
+#endif /* ESSRESAMPLINGPOLICY_H */
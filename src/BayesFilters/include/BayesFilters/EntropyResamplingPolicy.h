@@ -0,0 +1,30 @@
+#ifndef ENTROPYRESAMPLINGPOLICY_H
+#define ENTROPYRESAMPLINGPOLICY_H
+
+#include "ResamplingPolicy.h"
+
+namespace bfl {
+    class EntropyResamplingPolicy;
+}
+
+
+/**
+ * Resample when the entropy of the weights falls below ratio times its
+ * maximum value log(N), attained by uniform weights.
+ */
+class bfl::EntropyResamplingPolicy : public ResamplingPolicy
+{
+public:
+    EntropyResamplingPolicy(double ratio) noexcept;
+
+    EntropyResamplingPolicy() noexcept;
+
+    virtual ~EntropyResamplingPolicy() noexcept;
+
+    bool resample(const WeightStatistics& statistics, const unsigned int step) override;
+
+protected:
+    double ratio_;
+};
+
+#endif /* ENTROPYRESAMPLINGPOLICY_H */
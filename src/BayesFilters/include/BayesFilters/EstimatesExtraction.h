@@ -7,6 +7,7 @@
 #include <Eigen/Core>
 
 #include <BayesFilters/HistoryBuffer.h>
+#include <BayesFilters/StateLayout.h>
 
 namespace bfl {
     class EstimatesExtraction;
@@ -16,7 +17,14 @@ namespace bfl {
 class bfl::EstimatesExtraction
 {
 public:
-    EstimatesExtraction() noexcept { };
+    /**
+     * Extraction for the 7-dimensional layout of the visual trackers, i.e.
+     * 3D position, axis of rotation and angle of rotation. Particles of any
+     * other size are treated as linear states.
+     */
+    EstimatesExtraction() noexcept;
+
+    EstimatesExtraction(const StateLayout& state_layout) noexcept;
 
     EstimatesExtraction(EstimatesExtraction&& estimate_extraction) noexcept;
 
@@ -42,6 +50,14 @@ public:
 
     bool setMobileAverageWindowSize(const int window);
 
+    void setStateLayout(const StateLayout& state_layout);
+
+    const StateLayout& getStateLayout() const;
+
+    /**
+     * Throw if the particle size does not match the size of the state layout
+     * given to the constructor or to setStateLayout().
+     */
     Eigen::VectorXf extract(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights);
 
     bool clear();
@@ -52,11 +68,13 @@ public:
 protected:
     ExtractionMethod extraction_method_ = ExtractionMethod::emode;
 
-    HistoryBuffer hist_buffer_;
+    StateLayout state_layout_;
 
-    Eigen::VectorXf sm_weights_;
-    Eigen::VectorXf wm_weights_;
-    Eigen::VectorXf em_weights_;
+    /* Whether state_layout_ is the default one, replaced by a linear layout for particles of other sizes */
+    bool default_state_layout_ = false;
+
+    /* History of the lifted estimates, see liftEstimate() */
+    HistoryBuffer hist_buffer_;
 
 
     enum class Statistics
@@ -65,10 +83,30 @@ protected:
         mode
     };
 
+    /**
+     * Weighted mean according to the state layout. Linear blocks are a
+     * matrix-vector product, angle blocks average sines and cosines computed
+     * on whole rows, unit vectors are normalized (the mode is used if they
+     * average to almost zero) and quaternions take the principal eigenvector
+     * of their weighted scatter matrix.
+     */
     Eigen::VectorXf mean(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights) const;
 
     Eigen::VectorXf mode(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights) const;
 
+    /**
+     * Map an estimate to a vector whose linear averages give the layout-aware
+     * average: linear and unit vector blocks are copied, angles become sine
+     * and cosine pairs and quaternions q become vec(q q').
+     */
+    Eigen::VectorXf liftEstimate(const Eigen::Ref<const Eigen::VectorXf>& estimate) const;
+
+    /**
+     * Map back an average of lifted estimates. Unit vectors averaging to
+     * almost zero and the sign of quaternions are taken from last_estimate.
+     */
+    Eigen::VectorXf lowerEstimate(const Eigen::Ref<const Eigen::VectorXf>& lifted_average, const Eigen::Ref<const Eigen::VectorXf>& last_estimate) const;
+
     Eigen::VectorXf simpleAverage(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights,
                                   const Statistics& base_est_ext);
 
@@ -1,7 +1,11 @@
 #ifndef FILTERINGALGORITHM_H
 #define FILTERINGALGORITHM_H
 
+#include "FilteringExecutor.h"
+
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -18,10 +22,24 @@ namespace bfl {
 class bfl::FilteringAlgorithm
 {
 public:
-    virtual ~FilteringAlgorithm() noexcept { };
+    /**
+     * A filter booted on an executor is torn down and its queued task, if
+     * any, is waited for, since it refers to the filter. The task does not
+     * call the derived class once torn down.
+     */
+    virtual ~FilteringAlgorithm() noexcept;
 
     bool boot();
 
+    /**
+     * Boot on a shared executor instead of a dedicated thread. The filtering
+     * recursion runs as a sequence of tasks, one filtering step each, which
+     * are submitted as long as the filter runs, hence many filters can share
+     * the executor threads. run(), wait(), reset(), reboot() and teardown()
+     * behave as for a filter booted with boot().
+     */
+    bool boot(std::shared_ptr<FilteringExecutor> executor);
+
     void run();
 
     bool wait();
@@ -32,6 +50,14 @@ public:
 
     bool teardown();
 
+    /**
+     * Run one filtering step on the calling thread, without booting the
+     * filter. The first call, and the first call after reset() or reboot(),
+     * runs initialization() first. Return false, without stepping, once
+     * runCondition() is false or after teardown().
+     */
+    bool step();
+
     unsigned int getFilteringStep();
 
     bool isRunning();
@@ -47,6 +73,12 @@ protected:
 
     virtual bool runCondition() = 0;
 
+    /**
+     * Initialize the filter if required, as done by step(), and return
+     * whether a filtering step can run.
+     */
+    bool prepareStep();
+
 private:
     unsigned int filtering_step_ = 0;
 
@@ -54,15 +86,34 @@ private:
 
     void         filteringRecursion();
 
+    /**
+     * One step of the filtering recursion, as run on the executor.
+     */
+    void         filteringTask();
+
+    void         submitTask();
+
+
+    std::shared_ptr<FilteringExecutor> executor_;
+
+    bool                    task_scheduled_ = false;
+
+    bool                    task_done_ = false;
+
+    std::condition_variable cv_task_done_;
+
 
     std::mutex              mtx_run_;
     std::condition_variable cv_run_;
 
-    bool                    run_      = false;
+    /* Read by the thread, or the executor worker, running the filtering steps. */
+    std::atomic<bool>       run_{false};
+
+    std::atomic<bool>       reset_{false};
 
-    bool                    reset_    = false;
+    std::atomic<bool>       teardown_{false};
 
-    bool                    teardown_ = false;
+    bool                    initialization_pending_ = true;
 };
 
 #endif /* FILTERINGALGORITHM_H */
@@ -0,0 +1,83 @@
+#ifndef FILTERINGEXECUTOR_H
+#define FILTERINGEXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bfl {
+    class FilteringExecutor;
+}
+
+
+/**
+ * A work-stealing pool of worker threads running short tasks, used to run
+ * many FilteringAlgorithm instances without a thread each, see
+ * FilteringAlgorithm::boot(std::shared_ptr<FilteringExecutor>).
+ *
+ * Each worker owns a queue of tasks. Tasks submitted by a worker go to its
+ * own queue, the others are distributed in round-robin. A worker runs the
+ * tasks of its queue in submission order and, when it runs out of them,
+ * steals from the back of the queues of the other workers.
+ */
+class bfl::FilteringExecutor
+{
+public:
+    /**
+     * A pool of num_threads workers, or of one worker per core if zero.
+     */
+    FilteringExecutor(const unsigned int num_threads);
+
+    FilteringExecutor();
+
+    /**
+     * Tasks still queued are discarded, hence filters running on the
+     * executor should be waited for before destroying it.
+     */
+    ~FilteringExecutor() noexcept;
+
+    FilteringExecutor(const FilteringExecutor& filtering_executor) = delete;
+
+    FilteringExecutor& operator=(const FilteringExecutor& filtering_executor) = delete;
+
+
+    void submit(std::function<void()> task);
+
+    unsigned int getNumThreads() const;
+
+private:
+    struct TaskQueue
+    {
+        std::mutex                        mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(const unsigned int index);
+
+    bool popTask(const unsigned int index, std::function<void()>& task);
+
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+
+    std::vector<std::thread>                workers_;
+
+    std::atomic<unsigned int>               next_queue_;
+
+    std::mutex                              mtx_idle_;
+    std::condition_variable                 cv_idle_;
+
+    long                                    num_tasks_ = 0;
+
+    bool                                    teardown_  = false;
+
+    /* Executor and queue of the worker running on the current thread, if any */
+    static thread_local FilteringExecutor*  local_executor_;
+    static thread_local unsigned int        local_index_;
+};
+
+#endif /* FILTERINGEXECUTOR_H */
@@ -0,0 +1,50 @@
+#ifndef FIXEDDRAWPARTICLES_H
+#define FIXEDDRAWPARTICLES_H
+
+#include "FixedPFPrediction.h"
+
+#include <memory>
+#include <utility>
+
+namespace bfl {
+    template<int StateSize> class FixedDrawParticles;
+}
+
+
+/**
+ * Counterpart of DrawParticles for a state size known at compile time.
+ */
+template<int StateSize>
+class bfl::FixedDrawParticles : public FixedPFPrediction<StateSize>
+{
+public:
+    typedef typename FixedPFPrediction<StateSize>::StateMatrix StateMatrix;
+
+
+    FixedDrawParticles() noexcept { };
+
+    virtual ~FixedDrawParticles() noexcept { };
+
+    FixedStateModel<StateSize>& getStateModel() override
+    {
+        return *state_model_;
+    }
+
+    void setStateModel(std::unique_ptr<FixedStateModel<StateSize>> state_model) override
+    {
+        state_model_ = std::move(state_model);
+    }
+
+protected:
+    void predictStep(const Eigen::Ref<const StateMatrix>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
+                     Eigen::Ref<StateMatrix> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) override
+    {
+        state_model_->motion(prev_states, pred_states);
+
+        pred_weights = prev_weights;
+    }
+
+    std::unique_ptr<FixedStateModel<StateSize>> state_model_;
+};
+
+#endif /* FIXEDDRAWPARTICLES_H */
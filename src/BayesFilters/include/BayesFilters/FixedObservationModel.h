@@ -0,0 +1,37 @@
+#ifndef FIXEDOBSERVATIONMODEL_H
+#define FIXEDOBSERVATIONMODEL_H
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    template<int StateSize, int MeasurementSize> class FixedObservationModel;
+}
+
+
+/**
+ * Counterpart of ObservationModel for state and measurement sizes known at
+ * compile time.
+ */
+template<int StateSize, int MeasurementSize>
+class bfl::FixedObservationModel
+{
+public:
+    typedef Eigen::Matrix<float, StateSize, Eigen::Dynamic>       StateMatrix;
+
+    typedef Eigen::Matrix<float, MeasurementSize, 1>              MeasurementVector;
+
+    typedef Eigen::Matrix<float, MeasurementSize, Eigen::Dynamic> MeasurementMatrix;
+
+    typedef Eigen::Matrix<float, MeasurementSize, MeasurementSize> CovarianceMatrix;
+
+
+    virtual ~FixedObservationModel() noexcept { };
+
+    virtual void observe(const Eigen::Ref<const StateMatrix>& cur_states, Eigen::Ref<MeasurementMatrix> observations) = 0;
+
+    virtual void measure(const Eigen::Ref<const StateMatrix>& cur_states, Eigen::Ref<MeasurementMatrix> measurements) = 0;
+
+    virtual CovarianceMatrix getNoiseCovarianceMatrix() = 0;
+};
+
+#endif /* FIXEDOBSERVATIONMODEL_H */
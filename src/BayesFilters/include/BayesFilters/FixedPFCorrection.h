@@ -0,0 +1,64 @@
+#ifndef FIXEDPFCORRECTION_H
+#define FIXEDPFCORRECTION_H
+
+#include "FixedObservationModel.h"
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    template<int StateSize, int MeasurementSize> class FixedPFCorrection;
+}
+
+
+/**
+ * Counterpart of PFCorrection for state and measurement sizes known at
+ * compile time.
+ */
+template<int StateSize, int MeasurementSize>
+class bfl::FixedPFCorrection
+{
+public:
+    typedef typename FixedObservationModel<StateSize, MeasurementSize>::StateMatrix       StateMatrix;
+
+    typedef typename FixedObservationModel<StateSize, MeasurementSize>::MeasurementVector MeasurementVector;
+
+
+    virtual ~FixedPFCorrection() noexcept { };
+
+    void correct(const Eigen::Ref<const StateMatrix>& pred_states, const Eigen::Ref<const Eigen::VectorXf>& pred_weights, const Eigen::Ref<const MeasurementVector>& measurement,
+                 Eigen::Ref<StateMatrix> cor_states, Eigen::Ref<Eigen::VectorXf> cor_weights)
+    {
+        if (!skip_)
+            correctStep(pred_states, pred_weights, measurement,
+                        cor_states, cor_weights);
+        else
+        {
+            cor_states  = pred_states;
+            cor_weights = pred_weights;
+        }
+    }
+
+    bool skip(const bool status)
+    {
+        skip_ = status;
+
+        return true;
+    }
+
+    virtual FixedObservationModel<StateSize, MeasurementSize>& getObservationModel() = 0;
+
+    virtual void setObservationModel(std::unique_ptr<FixedObservationModel<StateSize, MeasurementSize>> observation_model) = 0;
+
+protected:
+    FixedPFCorrection() noexcept { };
+
+    virtual void correctStep(const Eigen::Ref<const StateMatrix>& pred_states, const Eigen::Ref<const Eigen::VectorXf>& pred_weights, const Eigen::Ref<const MeasurementVector>& measurement,
+                             Eigen::Ref<StateMatrix> cor_states, Eigen::Ref<Eigen::VectorXf> cor_weights) = 0;
+
+private:
+    bool skip_ = false;
+};
+
+#endif /* FIXEDPFCORRECTION_H */
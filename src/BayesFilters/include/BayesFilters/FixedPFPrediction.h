@@ -0,0 +1,61 @@
+#ifndef FIXEDPFPREDICTION_H
+#define FIXEDPFPREDICTION_H
+
+#include "FixedStateModel.h"
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    template<int StateSize> class FixedPFPrediction;
+}
+
+
+/**
+ * Counterpart of PFPrediction for a state size known at compile time.
+ */
+template<int StateSize>
+class bfl::FixedPFPrediction
+{
+public:
+    typedef typename FixedStateModel<StateSize>::StateMatrix StateMatrix;
+
+
+    virtual ~FixedPFPrediction() noexcept { };
+
+    void predict(const Eigen::Ref<const StateMatrix>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
+                 Eigen::Ref<StateMatrix> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights)
+    {
+        if (!skip_)
+            predictStep(prev_states, prev_weights,
+                        pred_states, pred_weights);
+        else
+        {
+            pred_states  = prev_states;
+            pred_weights = prev_weights;
+        }
+    }
+
+    bool skip(const bool status)
+    {
+        skip_ = status;
+
+        return true;
+    }
+
+    virtual FixedStateModel<StateSize>& getStateModel() = 0;
+
+    virtual void setStateModel(std::unique_ptr<FixedStateModel<StateSize>> state_model) = 0;
+
+protected:
+    FixedPFPrediction() noexcept { };
+
+    virtual void predictStep(const Eigen::Ref<const StateMatrix>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
+                             Eigen::Ref<StateMatrix> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) = 0;
+
+private:
+    bool skip_ = false;
+};
+
+#endif /* FIXEDPFPREDICTION_H */
@@ -0,0 +1,129 @@
+#ifndef FIXEDSIS_H
+#define FIXEDSIS_H
+
+#include "ESSResamplingPolicy.h"
+#include "FilteringAlgorithm.h"
+#include "FixedPFCorrection.h"
+#include "FixedPFPrediction.h"
+#include "Resampling.h"
+#include "ResamplingPolicy.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    template<int StateSize, int MeasurementSize> class FixedSIS;
+}
+
+
+/**
+ * Sequential importance sampling particle filter for state and measurement
+ * sizes known at compile time. Derived classes initialize pred_particle_ and
+ * pred_weight_ in initialization() and provide the measurement of each
+ * filtering step through getMeasurement().
+ */
+template<int StateSize, int MeasurementSize>
+class bfl::FixedSIS : public FilteringAlgorithm
+{
+public:
+    typedef Eigen::Matrix<float, StateSize, Eigen::Dynamic> StateMatrix;
+
+    typedef Eigen::Matrix<float, MeasurementSize, 1>        MeasurementVector;
+
+
+    virtual ~FixedSIS() noexcept { };
+
+    void setPrediction(std::unique_ptr<FixedPFPrediction<StateSize>> prediction)
+    {
+        prediction_ = std::move(prediction);
+    }
+
+    void setCorrection(std::unique_ptr<FixedPFCorrection<StateSize, MeasurementSize>> correction)
+    {
+        correction_ = std::move(correction);
+    }
+
+    void setResampling(std::unique_ptr<Resampling> resampling)
+    {
+        resampling_ = std::move(resampling);
+    }
+
+    void setResamplingPolicy(std::unique_ptr<ResamplingPolicy> resampling_policy)
+    {
+        resampling_policy_ = std::move(resampling_policy);
+    }
+
+    bool skip(const std::string& what_step, const bool status) override
+    {
+        if (what_step == "prediction")
+            return prediction_->skip(status);
+
+        if (what_step == "correction")
+            return correction_->skip(status);
+
+        if (what_step == "all")
+            return prediction_->skip(status) && correction_->skip(status);
+
+        return false;
+    }
+
+protected:
+    FixedSIS() noexcept :
+        resampling_policy_(new ESSResamplingPolicy()) { };
+
+    virtual void getMeasurement(Eigen::Ref<MeasurementVector> measurement) = 0;
+
+    void filteringStep() override
+    {
+        const unsigned int k = getFilteringStep();
+
+        if (k != 0)
+            prediction_->predict(cor_particle_, cor_weight_,
+                                 pred_particle_, pred_weight_);
+
+        getMeasurement(measurement_);
+
+        correction_->correct(pred_particle_, pred_weight_, measurement_,
+                             cor_particle_, cor_weight_);
+
+        const WeightStatistics statistics = normalizeWeights(cor_weight_, false, nullptr, block_statistics_);
+
+        if (resampling_policy_->resample(statistics, k))
+        {
+            res_particle_.resize(StateSize, cor_particle_.cols());
+            res_weight_.resize(cor_weight_.size());
+            res_parent_.resize(cor_weight_.size());
+
+            resampling_->resample(cor_particle_, cor_weight_,
+                                  res_particle_, res_weight_, res_parent_);
+
+            cor_particle_.swap(res_particle_);
+            cor_weight_.swap(res_weight_);
+        }
+    }
+
+    std::unique_ptr<FixedPFPrediction<StateSize>>                  prediction_;
+    std::unique_ptr<FixedPFCorrection<StateSize, MeasurementSize>> correction_;
+    std::unique_ptr<Resampling>                                    resampling_;
+    std::unique_ptr<ResamplingPolicy>                              resampling_policy_;
+
+    MeasurementVector                                              measurement_;
+
+    StateMatrix                                                    pred_particle_;
+    Eigen::VectorXf                                                pred_weight_;
+
+    StateMatrix                                                    cor_particle_;
+    Eigen::VectorXf                                                cor_weight_;
+
+    StateMatrix                                                    res_particle_;
+    Eigen::VectorXf                                                res_weight_;
+    Eigen::VectorXf                                                res_parent_;
+
+private:
+    Eigen::MatrixXd                                                block_statistics_;
+};
+
+#endif /* FIXEDSIS_H */
@@ -0,0 +1,37 @@
+#ifndef FIXEDSTATEMODEL_H
+#define FIXEDSTATEMODEL_H
+
+#include <cstdint>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    template<int StateSize> class FixedStateModel;
+}
+
+
+/**
+ * Counterpart of StateModel for a state size known at compile time, so that
+ * the per-particle math can be unrolled and vectorized by Eigen.
+ */
+template<int StateSize>
+class bfl::FixedStateModel
+{
+public:
+    typedef Eigen::Matrix<float, StateSize, 1>              StateVector;
+
+    typedef Eigen::Matrix<float, StateSize, Eigen::Dynamic> StateMatrix;
+
+    typedef Eigen::Matrix<float, StateSize, StateSize>      CovarianceMatrix;
+
+
+    virtual ~FixedStateModel() noexcept { };
+
+    virtual void propagate(const Eigen::Ref<const StateMatrix>& cur_states, Eigen::Ref<StateMatrix> prop_states) = 0;
+
+    virtual void motion(const Eigen::Ref<const StateMatrix>& cur_states, Eigen::Ref<StateMatrix> mot_states) = 0;
+
+    virtual CovarianceMatrix getNoiseCovarianceMatrix() = 0;
+};
+
+#endif /* FIXEDSTATEMODEL_H */
@@ -0,0 +1,71 @@
+#ifndef FIXEDUPDATEPARTICLES_H
+#define FIXEDUPDATEPARTICLES_H
+
+#include "FixedPFCorrection.h"
+
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include <Eigen/Cholesky>
+
+namespace bfl {
+    template<int StateSize, int MeasurementSize> class FixedUpdateParticles;
+}
+
+
+/**
+ * Counterpart of UpdateParticles for state and measurement sizes known at
+ * compile time. Particles are weighted by the Gaussian likelihood of the
+ * innovations, whitened with the Cholesky factor of the fixed-size noise
+ * covariance matrix.
+ */
+template<int StateSize, int MeasurementSize>
+class bfl::FixedUpdateParticles : public FixedPFCorrection<StateSize, MeasurementSize>
+{
+public:
+    typedef typename FixedPFCorrection<StateSize, MeasurementSize>::StateMatrix       StateMatrix;
+
+    typedef typename FixedPFCorrection<StateSize, MeasurementSize>::MeasurementVector MeasurementVector;
+
+    typedef Eigen::Matrix<float, MeasurementSize, Eigen::Dynamic>                     MeasurementMatrix;
+
+
+    FixedUpdateParticles() noexcept { };
+
+    virtual ~FixedUpdateParticles() noexcept { };
+
+    FixedObservationModel<StateSize, MeasurementSize>& getObservationModel() override
+    {
+        return *observation_model_;
+    }
+
+    void setObservationModel(std::unique_ptr<FixedObservationModel<StateSize, MeasurementSize>> observation_model) override
+    {
+        observation_model_ = std::move(observation_model);
+    }
+
+protected:
+    void correctStep(const Eigen::Ref<const StateMatrix>& pred_states, const Eigen::Ref<const Eigen::VectorXf>& pred_weights, const Eigen::Ref<const MeasurementVector>& measurement,
+                     Eigen::Ref<StateMatrix> cor_states, Eigen::Ref<Eigen::VectorXf> cor_weights) override
+    {
+        innovations_.resize(MeasurementSize, pred_states.cols());
+        observation_model_->observe(pred_states, innovations_);
+        innovations_ = (-innovations_).colwise() + measurement;
+
+        const Eigen::LLT<Eigen::Matrix<float, MeasurementSize, MeasurementSize>> noise_covariance_llt(observation_model_->getNoiseCovarianceMatrix());
+        noise_covariance_llt.matrixL().solveInPlace(innovations_);
+
+        const float log_normalization = -0.5f * MeasurementSize * std::log(2.0f * static_cast<float>(M_PI))
+                                        - noise_covariance_llt.matrixLLT().diagonal().array().log().sum();
+
+        cor_states  = pred_states;
+        cor_weights = pred_weights.array() * (log_normalization - 0.5f * innovations_.colwise().squaredNorm().transpose().array()).exp();
+    }
+
+    std::unique_ptr<FixedObservationModel<StateSize, MeasurementSize>> observation_model_;
+
+    MeasurementMatrix                                                  innovations_;
+};
+
+#endif /* FIXEDUPDATEPARTICLES_H */
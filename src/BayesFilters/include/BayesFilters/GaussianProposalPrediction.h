@@ -0,0 +1,127 @@
+#ifndef GAUSSIANPROPOSALPREDICTION_H
+#define GAUSSIANPROPOSALPREDICTION_H
+
+#include "GaussianSampler.h"
+#include "ObservationModel.h"
+#include "PFPrediction.h"
+#include "SigmaPointTransform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
+
+namespace bfl {
+    class GaussianProposalPrediction;
+}
+
+
+/**
+ * Prediction drawing each particle from a Gaussian approximation of
+ * p(x_k | x_k-1, z_k), i.e. a proposal that accounts for the measurement of
+ * the upcoming correction, in place of the state transition density.
+ *
+ * The models are assumed to have additive Gaussian noise,
+ * x_k = f(x_k-1) + w_k and z_k = h(x_k) + v_k. For every particle, the
+ * proposal is the Kalman update of N(f(x_k-1), Q), with the moments of h
+ * computed by a sigma-point transform (the unscented transform by default).
+ * Since the covariance Q is shared by all the particles, so are the sigma
+ * point offsets: the sigma points of a whole block of particles are observed
+ * with a single call to ObservationModel::observe().
+ *
+ * The predicted weights are multiplied by p(x_k | x_k-1) / q(x_k | x_k-1, z_k),
+ * hence any PFCorrection multiplying them by the likelihood can follow.
+ * With linear models the proposal is the optimal one. When no measurement is
+ * set, the particles are drawn from the state transition density.
+ */
+class bfl::GaussianProposalPrediction : public PFPrediction
+{
+public:
+    GaussianProposalPrediction(const std::uint64_t seed) noexcept;
+
+    GaussianProposalPrediction() noexcept;
+
+    GaussianProposalPrediction(GaussianProposalPrediction&& prediction) noexcept;
+
+    virtual ~GaussianProposalPrediction() noexcept;
+
+    StateModel& getStateModel() override;
+
+    void setStateModel(std::unique_ptr<StateModel> state_model) override;
+
+    ObservationModel& getObservationModel();
+
+    void setObservationModel(std::unique_ptr<ObservationModel> observation_model);
+
+    void setSigmaPointTransform(std::unique_ptr<SigmaPointTransform> sigma_point_transform);
+
+    void setMeasurement(const Eigen::Ref<const Eigen::VectorXf>& measurement) override;
+
+    void resetNoise() override;
+
+protected:
+    void predictStep(const Eigen::Ref<const Eigen::MatrixXf>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
+                     Eigen::Ref<Eigen::MatrixXf> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) override;
+
+    /**
+     * Temporaries of proposalBlock(), one set per block of particles, sized
+     * in predictStep() for the largest block.
+     */
+    struct BlockWorkspace
+    {
+        Eigen::MatrixXf             prior_means;
+        Eigen::MatrixXf             noise;
+        Eigen::MatrixXf             sigma_points;
+        Eigen::MatrixXf             observations;
+        Eigen::VectorXf             pred_measurement;
+        Eigen::VectorXf             innovation;
+        Eigen::MatrixXf             deviations;
+        Eigen::MatrixXf             weighted_deviations;
+        Eigen::MatrixXf             S;
+        Eigen::LLT<Eigen::MatrixXf> S_llt;
+        Eigen::MatrixXf             C;
+        Eigen::MatrixXf             Kt;
+        Eigen::MatrixXf             covariance;
+        Eigen::LLT<Eigen::MatrixXf> covariance_llt;
+        Eigen::VectorXf             mean;
+        Eigen::VectorXf             residual;
+    };
+
+    /**
+     * Draw the particles of a block from the proposal and write the
+     * log-weight increments in log_ratios.
+     */
+    void proposalBlock(const Eigen::Ref<const Eigen::MatrixXf>& prev_states, Eigen::Ref<Eigen::MatrixXf> pred_states,
+                       Eigen::Ref<Eigen::VectorXf> log_ratios, const std::size_t first_particle, BlockWorkspace& workspace);
+
+    std::unique_ptr<StateModel>          state_model_;
+
+    std::unique_ptr<ObservationModel>    observation_model_;
+
+    std::unique_ptr<SigmaPointTransform> sigma_point_transform_;
+
+    Eigen::VectorXf                      measurement_;
+
+    GaussianSampler                      gaussian_sampler_;
+
+    /* Key of the proposal noise, incremented at every prediction. */
+    std::uint64_t                        noise_step_ = 0;
+
+private:
+    /* Quantities shared by all the particles, updated at every prediction */
+    Eigen::MatrixXf                      R_;
+    Eigen::LLT<Eigen::MatrixXf>          Q_llt_;
+    Eigen::MatrixXf                      Q_;
+    float                                Q_log_det_ = 0.0f;
+    Eigen::MatrixXf                      sigma_offsets_;           /* Sigma points of N(0, Q) */
+    Eigen::MatrixXf                      weighted_deviations_;     /* Sigma point offsets minus their mean, times the covariance weights */
+
+    Eigen::VectorXf                      log_ratios_;
+
+    std::vector<BlockWorkspace>          block_workspaces_;
+};
+
+#endif /* GAUSSIANPROPOSALPREDICTION_H */
@@ -0,0 +1,64 @@
+#ifndef GAUSSIANSAMPLER_H
+#define GAUSSIANSAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Philox.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class GaussianSampler;
+}
+
+
+/**
+ * Fill whole matrices with independent standard normal samples.
+ * Uniforms are drawn from num_lanes interleaved xoshiro256+ generators,
+ * stored lane-wise so that the compiler can vectorize them, and transformed
+ * by a vectorized Box-Muller transform. State and observation models can
+ * use it in place of a per-scalar std::normal_distribution.
+ *
+ * The keyed fill() draws from a counter-based Philox generator instead: the
+ * samples of a column depend only on the seed, a stream index (e.g. the
+ * filtering step) and the global column index (e.g. the particle index).
+ */
+class bfl::GaussianSampler
+{
+public:
+    GaussianSampler(const std::uint64_t seed) noexcept;
+
+    GaussianSampler() noexcept;
+
+    virtual ~GaussianSampler() noexcept;
+
+    void seed(const std::uint64_t seed);
+
+    void fill(Eigen::Ref<Eigen::MatrixXf> samples);
+
+    /**
+     * Fill column j of samples with the samples of column first_column + j
+     * of stream. Only the lower 32 bits of stream are used. The result does
+     * not depend on how a matrix is split in blocks of columns, hence on the
+     * number of threads, and this method can be called concurrently.
+     */
+    void fill(Eigen::Ref<Eigen::MatrixXf> samples, const std::uint64_t stream, const std::uint64_t first_column) const;
+
+    Eigen::MatrixXf sample(const std::size_t rows, const std::size_t cols);
+
+    static constexpr std::size_t num_lanes = 16;
+
+protected:
+    /**
+     * Write 2 * num_lanes standard normal samples in samples.
+     */
+    void fillBlock(float* samples);
+
+private:
+    std::uint64_t state_[4][num_lanes];
+
+    Philox        philox_;
+};
+
+#endif /* GAUSSIANSAMPLER_H */
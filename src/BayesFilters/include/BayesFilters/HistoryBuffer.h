@@ -1,8 +1,6 @@
 #ifndef HISTORYBUFFER_H
 #define HISTORYBUFFER_H
 
-#include <deque>
-
 #include <Eigen/Core>
 
 namespace bfl {
@@ -10,6 +8,14 @@ namespace bfl {
 }
 
 
+/**
+ * Moving window of the most recent vectors added to the buffer.
+ * The vectors are stored in a ring buffer, i.e. the columns of a single
+ * matrix allocated when the first vector is added, and the weighted sums
+ * behind the simple, linearly weighted and exponential moving averages are
+ * updated incrementally, so that adding a vector and reading an average cost
+ * O(size of the vectors).
+ */
 class bfl::HistoryBuffer
 {
 public:
@@ -23,8 +29,35 @@ public:
 
     void            addElement(const Eigen::Ref<const Eigen::VectorXf>& element);
 
+    /**
+     * Copy of the elements in the window, from the most recent to the oldest.
+     */
     Eigen::MatrixXf getHistoryBuffer() const;
 
+    /**
+     * The i-th most recent element, i = 0 being the last added.
+     */
+    Eigen::MatrixXf::ConstColXpr getElement(const unsigned int i) const;
+
+    unsigned int    getNumElements() const { return num_elements_; };
+
+    /**
+     * Mean of the elements in the window.
+     */
+    Eigen::VectorXf getSimpleAverage() const;
+
+    /**
+     * Weighted mean of the n elements in the window, with weights decreasing
+     * linearly from n, for the most recent element, to 1.
+     */
+    Eigen::VectorXf getLinearAverage() const;
+
+    /**
+     * Weighted mean of the n elements in the window, with weights exp(-i / n)
+     * for the i-th most recent element.
+     */
+    Eigen::VectorXf getExponentialAverage() const;
+
     bool            setHistorySize(const unsigned int window);
 
     unsigned int    getHistorySize() const { return window_; };
@@ -36,11 +69,32 @@ public:
     bool            clear();
 
 private:
-    unsigned int                window_     = 5;
+    /**
+     * Index of the column of the i-th most recent element.
+     */
+    unsigned int    index(const unsigned int i) const;
+
+    /**
+     * Recompute the weighted sums from the stored elements, discarding the
+     * rounding errors accumulated by the incremental updates.
+     */
+    void            recomputeSums();
+
+    unsigned int       window_       = 5;
+
+    const unsigned int max_window_   = 30;
+
+    Eigen::MatrixXf    buffer_;                /* max_window_ columns, allocated by the first addElement() */
+
+    unsigned int       newest_       = 0;
+
+    unsigned int       num_elements_ = 0;
+
+    Eigen::VectorXd    sum_;
 
-    const unsigned int          max_window_ = 30;
+    Eigen::VectorXd    linear_sum_;
 
-    std::deque<Eigen::VectorXf> history_buffer_;
+    Eigen::VectorXd    exponential_sum_;
 };
 
 #endif /* HISTORYBUFFER_H */
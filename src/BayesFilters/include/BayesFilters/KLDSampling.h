@@ -0,0 +1,75 @@
+#ifndef KLDSAMPLING_H
+#define KLDSAMPLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class KLDSampling;
+}
+
+
+/**
+ * KLD-sampling [Fox, 2003]: choose the number of particles such that, with
+ * probability 1 - delta, the Kullback-Leibler divergence between the
+ * particle approximation and the true posterior is below epsilon. The
+ * posterior support is measured as the number of histogram bins occupied by
+ * the particles.
+ */
+class bfl::KLDSampling
+{
+public:
+    /**
+     * Particles are binned with a grid of cell size bin_size(i) along state
+     * component i; components with a non-positive bin size are not binned.
+     *
+     * Requires epsilon > 0 and delta in (0, 0.5]. Values out of range are
+     * clamped to the nearest valid one, i.e. a non-positive epsilon or delta
+     * becomes the smallest positive double and delta above 0.5 becomes 0.5.
+     */
+    KLDSampling(const Eigen::Ref<const Eigen::VectorXf>& bin_size, const double epsilon, const double delta,
+                const std::size_t min_particles, const std::size_t max_particles) noexcept;
+
+    KLDSampling(KLDSampling&& kld_sampling) noexcept;
+
+    ~KLDSampling() noexcept;
+
+    KLDSampling& operator=(KLDSampling&& kld_sampling) noexcept;
+
+    /**
+     * Number of particles required for the support covered by particles,
+     * clamped to [min_particles, max_particles].
+     */
+    std::size_t numParticles(const Eigen::Ref<const Eigen::MatrixXf>& particles);
+
+    /**
+     * Number of particles required for num_bins occupied bins, clamped to
+     * [min_particles, max_particles].
+     */
+    std::size_t numParticles(const std::size_t num_bins) const;
+
+    std::size_t countBins(const Eigen::Ref<const Eigen::MatrixXf>& particles);
+
+private:
+    /**
+     * Upper 1 - p quantile of the standard normal distribution.
+     */
+    static double normalUpperQuantile(const double p);
+
+    Eigen::VectorXf                   bin_size_;
+
+    double                            epsilon_;
+
+    double                            z_;
+
+    std::size_t                       min_particles_;
+
+    std::size_t                       max_particles_;
+
+    std::unordered_set<std::uint64_t> bins_;
+};
+
+#endif /* KLDSAMPLING_H */
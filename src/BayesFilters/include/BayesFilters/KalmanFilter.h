@@ -2,23 +2,111 @@
 #define KALMANFILTER_H
 
 #include "FilteringAlgorithm.h"
+#include "ObservationModel.h"
+#include "StateModel.h"
+
+#include <memory>
+#include <string>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
 
 namespace bfl {
     class KalmanFilter;
 }
 
 
+/**
+ * Kalman filter for linear Gaussian models. The state and observation models
+ * provide the noise covariance matrices (and simulate the target), while the
+ * state transition and measurement matrices are passed along with them.
+ * All the workspaces are allocated in initialization(), hence a filtering
+ * step does not allocate memory. The covariance update uses the Joseph form,
+ * which keeps it symmetric and positive definite.
+ */
 class bfl::KalmanFilter: public FilteringAlgorithm {
 public:
-    KalmanFilter();
+    KalmanFilter() noexcept;
+
+    KalmanFilter(KalmanFilter&& kf) noexcept;
 
     virtual ~KalmanFilter() noexcept;
 
+    KalmanFilter& operator=(KalmanFilter&& kf) noexcept;
+
+    void setStateModel(std::unique_ptr<StateModel> state_model, const Eigen::Ref<const Eigen::MatrixXf>& F);
+
+    void setObservationModel(std::unique_ptr<ObservationModel> observation_model, const Eigen::Ref<const Eigen::MatrixXf>& H);
+
+    bool skip(const std::string& what_step, const bool status) override;
+
     void initialization() override;
-    
+
     void filteringStep() override;
 
     void getResult() override;
+
+    bool runCondition() override { return (measurement_driven_ || getFilteringStep() < simulation_time_); };
+
+    using FilteringAlgorithm::step;
+
+    /**
+     * Run one filtering step on the calling thread with the given
+     * measurement and return the corrected state mean. The returned vector
+     * is valid until the next step.
+     *
+     * The first call makes the filter measurement-driven, restarting it if
+     * it already ran simulated steps: initialization() no longer simulates
+     * the object and its measurements, the number of steps is not bounded
+     * by the simulation length and the per-step results written by
+     * getResult() are not stored. Steps without a measurement, e.g. by
+     * run(), then reuse the last one.
+     */
+    const Eigen::VectorXf& step(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+protected:
+    void predict();
+
+    void correct(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+    unsigned int                      simulation_time_ = 100;
+
+    bool                              measurement_driven_ = false;
+
+    std::unique_ptr<StateModel>       state_model_;
+    std::unique_ptr<ObservationModel> observation_model_;
+
+    Eigen::MatrixXf                   F_;          /* State transition matrix */
+    Eigen::MatrixXf                   H_;          /* Measurement matrix */
+    Eigen::MatrixXf                   Q_;          /* Process noise covariance matrix, cached at initialization */
+    Eigen::MatrixXf                   R_;          /* Measurement noise covariance matrix, cached at initialization */
+
+    Eigen::MatrixXf                   object_;
+    Eigen::MatrixXf                   measurement_;
+
+    Eigen::VectorXf                   x_;          /* State mean */
+    Eigen::MatrixXf                   P_;          /* State covariance matrix */
+
+    Eigen::MatrixXf                   result_x_;
+    Eigen::MatrixXf                   result_P_;
+
+    bool                              skip_prediction_ = false;
+    bool                              skip_correction_ = false;
+
+private:
+    /* Workspaces */
+    Eigen::VectorXf                   x_pred_;
+    Eigen::MatrixXf                   P_pred_;
+    Eigen::MatrixXf                   FP_;
+    Eigen::VectorXf                   y_;
+    Eigen::MatrixXf                   PHt_;
+    Eigen::MatrixXf                   S_;
+    Eigen::LLT<Eigen::MatrixXf>       S_llt_;
+    Eigen::MatrixXf                   Kt_;
+    Eigen::MatrixXf                   K_;
+    Eigen::MatrixXf                   IKH_;
+    Eigen::MatrixXf                   IKHP_;
+    Eigen::MatrixXf                   KR_;
 };
 
 #endif /* KALMANFILTER_H */
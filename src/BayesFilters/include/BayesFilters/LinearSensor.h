@@ -1,9 +1,9 @@
 #ifndef LINEARSENSOR_H
 #define LINEARSENSOR_H
 
-#include <functional>
-#include <random>
+#include <mutex>
 
+#include "GaussianSampler.h"
 #include "ObservationModel.h"
 
 namespace bfl {
@@ -47,9 +47,8 @@ protected:
     Eigen::Matrix2f                 R_;                /* Measurement white noise convariance matrix */
 
     Eigen::Matrix2f                 sqrt_R_;           /* Square root matrix of the measurement white noise convariance matrix */
-    std::mt19937_64                 generator_;
-    std::normal_distribution<float> distribution_;
-    std::function<float()>          gauss_rnd_sample_; /* Random number generator from a Normal distribution */
+    GaussianSampler                 gaussian_sampler_; /* Block generator of standard normal samples */
+    std::mutex                      mtx_noise_;        /* Serializes noise sampling when particles are processed in parallel */
 };
 
 #endif /* LINEARSENSOR_H */
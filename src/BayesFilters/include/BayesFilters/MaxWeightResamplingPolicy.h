@@ -0,0 +1,29 @@
+#ifndef MAXWEIGHTRESAMPLINGPOLICY_H
+#define MAXWEIGHTRESAMPLINGPOLICY_H
+
+#include "ResamplingPolicy.h"
+
+namespace bfl {
+    class MaxWeightResamplingPolicy;
+}
+
+
+/**
+ * Resample when the largest normalized weight exceeds threshold.
+ */
+class bfl::MaxWeightResamplingPolicy : public ResamplingPolicy
+{
+public:
+    MaxWeightResamplingPolicy(double threshold) noexcept;
+
+    MaxWeightResamplingPolicy() noexcept;
+
+    virtual ~MaxWeightResamplingPolicy() noexcept;
+
+    bool resample(const WeightStatistics& statistics, const unsigned int step) override;
+
+protected:
+    double threshold_;
+};
+
+#endif /* MAXWEIGHTRESAMPLINGPOLICY_H */
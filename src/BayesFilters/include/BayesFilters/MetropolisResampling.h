@@ -0,0 +1,48 @@
+#ifndef METROPOLISRESAMPLING_H
+#define METROPOLISRESAMPLING_H
+
+#include "Resampling.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class MetropolisResampling;
+}
+
+
+/**
+ * Metropolis resampling [Murray et al., 2016]: every ancestor is the end
+ * point of a short Metropolis chain over the particle indices that only
+ * requires ratios of weights. No prefix sum is needed, hence the ancestors
+ * are computed independently and scale across threads. The result is
+ * slightly biased for a finite number of iterations, which should be
+ * increased for highly degenerate weights.
+ */
+class bfl::MetropolisResampling : public Resampling
+{
+public:
+    explicit MetropolisResampling(unsigned int seed) noexcept;
+
+    MetropolisResampling() noexcept;
+
+    MetropolisResampling(MetropolisResampling&& resampling) noexcept;
+
+    virtual ~MetropolisResampling() noexcept;
+
+    MetropolisResampling& operator=(MetropolisResampling&& resampling) noexcept;
+
+
+    /**
+     * Length of the Metropolis chain of every ancestor, 32 by default.
+     */
+    void setNumIterations(const unsigned int num_iterations);
+
+    unsigned int getNumIterations();
+
+    void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors) override;
+
+protected:
+    unsigned int num_iterations_ = 32;
+};
+
+#endif /* METROPOLISRESAMPLING_H */
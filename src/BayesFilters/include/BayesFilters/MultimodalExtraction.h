@@ -0,0 +1,126 @@
+#ifndef MULTIMODALEXTRACTION_H
+#define MULTIMODALEXTRACTION_H
+
+#include "ThreadPool.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class MultimodalExtraction;
+}
+
+
+/**
+ * Extraction of the main modes of a weighted particle set by grid-accelerated
+ * mean-shift clustering. Particles are first binned with a grid whose cell
+ * size is the kernel bandwidth, accumulating weight and weighted sum of the
+ * states of each cell. Mean-shift then runs on the cell centroids with an
+ * Epanechnikov kernel of radius equal to the bandwidth, hence each iteration
+ * only visits the 3^d cells around the current point and no pass over pairs
+ * of particles is needed. Cells converging to the same point form a cluster,
+ * which is reported with its weighted mean and its mass.
+ *
+ * Binning and mean-shift run on blocks of particles and cells on the thread
+ * pool, when set. The weights are linear weights, not necessarily
+ * normalized.
+ */
+class bfl::MultimodalExtraction
+{
+public:
+    /**
+     * Clusters are found along the state components i with bandwidth(i) > 0,
+     * the other components are only averaged within each cluster.
+     */
+    MultimodalExtraction(const Eigen::Ref<const Eigen::VectorXf>& bandwidth, const unsigned int max_modes) noexcept;
+
+    MultimodalExtraction(MultimodalExtraction&& multimodal_extraction) noexcept;
+
+    ~MultimodalExtraction() noexcept;
+
+    MultimodalExtraction& operator=(MultimodalExtraction&& multimodal_extraction) noexcept;
+
+    void setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
+    void setMaxIterations(const unsigned int max_iterations);
+
+    /**
+     * Cluster particles and return the number of modes found, at most
+     * max_modes. The modes are available from getModes() and getMasses().
+     */
+    unsigned int extract(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights);
+
+    /**
+     * Weighted means of the clusters found by the last extract(), one per
+     * column, sorted by decreasing mass.
+     */
+    const Eigen::MatrixXf& getModes() const;
+
+    /**
+     * Fraction of the total weight of each cluster found by the last extract().
+     */
+    const Eigen::VectorXf& getMasses() const;
+
+protected:
+    /**
+     * Accumulate weight and weighted sum of the particles falling in each
+     * cell of the grid.
+     */
+    void binParticles(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights);
+
+    /**
+     * Run mean-shift from the centroid of the given cell, in bandwidth-scaled
+     * coordinates, and write the converged point.
+     */
+    void meanShift(const std::size_t cell, Eigen::Ref<Eigen::VectorXd> point) const;
+
+    Eigen::VectorXf                              bandwidth_;
+
+    unsigned int                                 max_modes_;
+
+    unsigned int                                 max_iterations_ = 30;
+
+    std::shared_ptr<ThreadPool>                  thread_pool_;
+
+    Eigen::MatrixXf                              modes_;
+
+    Eigen::VectorXf                              masses_;
+
+private:
+    /**
+     * Occupied cells of the grid, with their weight and the weighted sum of
+     * the states falling in them, stored contiguously in order of insertion.
+     */
+    struct Cells
+    {
+        std::unordered_map<std::uint64_t, std::size_t> index;
+        std::vector<std::uint64_t>                     keys;
+        std::vector<double>                            weights;
+        std::vector<double>                            sums;
+    };
+
+    /**
+     * FNV-1a hash of the integer coordinates of the cell containing a point
+     * in bandwidth-scaled coordinates, displaced by the given cell offsets.
+     */
+    static std::uint64_t cellKey(const Eigen::Ref<const Eigen::VectorXd>& scaled_point, const Eigen::Ref<const Eigen::VectorXi>& offset);
+
+    static void addToCell(Cells& cells, const std::uint64_t key, const double weight, const double* sum, const std::size_t size);
+
+
+    std::vector<int>                             clustered_;      /* Components with positive bandwidth */
+
+    std::vector<Eigen::VectorXi>                 offsets_;        /* Offsets of the 3^d cells around a cell */
+
+    Cells                                        cells_;
+
+    Eigen::MatrixXd                              centroids_;      /* Bandwidth-scaled centroid of each cell */
+
+    Eigen::MatrixXd                              converged_;      /* Mean-shift fixed point reached from each cell */
+};
+
+#endif /* MULTIMODALEXTRACTION_H */
@@ -0,0 +1,35 @@
+#ifndef MULTINOMIALRESAMPLING_H
+#define MULTINOMIALRESAMPLING_H
+
+#include "Resampling.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class MultinomialResampling;
+}
+
+
+/**
+ * Multinomial resampling: every ancestor is drawn independently from the
+ * categorical distribution defined by the weights, by binary search of the
+ * cumulative weights.
+ */
+class bfl::MultinomialResampling : public Resampling
+{
+public:
+    MultinomialResampling(unsigned int seed) noexcept;
+
+    MultinomialResampling() noexcept;
+
+    MultinomialResampling(MultinomialResampling&& resampling) noexcept;
+
+    virtual ~MultinomialResampling() noexcept;
+
+    MultinomialResampling& operator=(MultinomialResampling&& resampling) noexcept;
+
+
+    void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors) override;
+};
+
+#endif /* MULTINOMIALRESAMPLING_H */
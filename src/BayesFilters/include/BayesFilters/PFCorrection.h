@@ -2,6 +2,7 @@
 #define PFCORRECTION_H
 
 #include "ObservationModel.h"
+#include "ThreadPool.h"
 
 #include <memory>
 
@@ -25,9 +26,28 @@ public:
 
     virtual double likelihood(const Eigen::Ref<const Eigen::VectorXf>& innovation) = 0;
 
+    virtual void likelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_weights);
+
+    virtual void logLikelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_log_weights);
+
 
     bool skip(const bool status);
 
+    /**
+     * When status is true, weights are treated as log-weights, i.e. the
+     * correction adds log-likelihoods to the predicted log-weights.
+     */
+    virtual void setLogWeights(const bool status);
+
+    bool getLogWeights();
+
+    /**
+     * Process the particles in blocks on thread_pool. The models must then be
+     * safe to be called concurrently on disjoint blocks of particles.
+     * Passing nullptr restores serial execution.
+     */
+    virtual void setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
 
     virtual ObservationModel& getObservationModel() = 0;
 
@@ -42,9 +62,13 @@ protected:
     virtual void correctStep(const Eigen::Ref<const Eigen::MatrixXf>& pred_states, const Eigen::Ref<const Eigen::VectorXf>& pred_weights, const Eigen::Ref<const Eigen::MatrixXf>& measurements,
                              Eigen::Ref<Eigen::MatrixXf> cor_states, Eigen::Ref<Eigen::VectorXf> cor_weights) = 0;
 
+    std::shared_ptr<ThreadPool> thread_pool_;
+
 private:
     bool skip_ = false;
 
+    bool log_weights_ = false;
+
     friend class PFCorrectionDecorator;
 };
 
@@ -17,6 +17,14 @@ public:
 
     double likelihood(const Eigen::Ref<const Eigen::VectorXf>& innovation) override;
 
+    void likelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_weights) override;
+
+    void logLikelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_log_weights) override;
+
+    void setLogWeights(const bool status) override;
+
+    void setThreadPool(std::shared_ptr<ThreadPool> thread_pool) override;
+
     virtual ObservationModel& getObservationModel() override;
 
     virtual void setObservationModel(std::unique_ptr<ObservationModel> observation_model) override;
@@ -3,6 +3,7 @@
 
 #include "ExogenousModel.h"
 #include "StateModel.h"
+#include "ThreadPool.h"
 
 #include <Eigen/Dense>
 #include <memory>
@@ -38,6 +39,36 @@ public:
 
     virtual void setExogenousModel(std::unique_ptr<ExogenousModel> exogenous_model);
 
+    /**
+     * Process the particles in blocks on thread_pool. The models must then be
+     * safe to be called concurrently on disjoint blocks of particles.
+     * Passing nullptr restores serial execution.
+     */
+    virtual void setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
+    /**
+     * When status is true, weights are treated as log-weights. Predictions
+     * that reweight the particles, i.e. that do not sample from the state
+     * transition density, add their log-weight increments.
+     */
+    virtual void setLogWeights(const bool status);
+
+    bool getLogWeights();
+
+    /**
+     * Measurement of the upcoming correction, set by the filter before every
+     * prediction. Proposals that account for the measurement use it, the
+     * default implementation ignores it.
+     */
+    virtual void setMeasurement(const Eigen::Ref<const Eigen::VectorXf>& /* measurement */) { }
+
+    /**
+     * Restart the keyed noise streams, if any, from their first key. Called by
+     * the filter at every (re)initialization, so that a reset or rebooted
+     * filter draws the same noise again.
+     */
+    virtual void resetNoise() { }
+
 protected:
     PFPrediction() noexcept;
 
@@ -47,6 +78,8 @@ protected:
     virtual void predictStep(const Eigen::Ref<const Eigen::MatrixXf>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
                              Eigen::Ref<Eigen::MatrixXf> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) = 0;
 
+    std::shared_ptr<ThreadPool> thread_pool_;
+
 private:
     bool skip_prediction_ = false;
 
@@ -54,6 +87,8 @@ private:
 
     bool skip_exogenous_  = false;
 
+    bool log_weights_     = false;
+
     friend class PFPredictionDecorator;
 };
 
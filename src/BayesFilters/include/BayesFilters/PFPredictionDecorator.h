@@ -30,6 +30,14 @@ protected:
 
     void setExogenousModel(std::unique_ptr<ExogenousModel> exogenous_model) override;
 
+    void setThreadPool(std::shared_ptr<ThreadPool> thread_pool) override;
+
+    void setLogWeights(const bool status) override;
+
+    void setMeasurement(const Eigen::Ref<const Eigen::VectorXf>& measurement) override;
+
+    void resetNoise() override;
+
 protected:
     void predictStep(const Eigen::Ref<const Eigen::MatrixXf>& prev_states, const Eigen::Ref<const Eigen::VectorXf>& prev_weights,
                      Eigen::Ref<Eigen::MatrixXf> pred_states, Eigen::Ref<Eigen::VectorXf> pred_weights) override;
@@ -6,9 +6,13 @@
 #include "PFCorrection.h"
 #include "PFPrediction.h"
 #include "Resampling.h"
+#include "ResamplingPolicy.h"
+#include "ThreadPool.h"
 
 #include <memory>
 
+#include <Eigen/Dense>
+
 namespace bfl{
     class ParticleFilter;
 }
@@ -25,8 +29,32 @@ public:
 
     void setResampling(std::unique_ptr<Resampling> resampling);
 
+    /**
+     * Set the criterion deciding when the particles are resampled. It can be
+     * changed while the filter is running. Defaults to ESSResamplingPolicy.
+     */
+    void setResamplingPolicy(std::unique_ptr<ResamplingPolicy> resampling_policy);
+
     virtual bool skip(const std::string& what_step, const bool status) override;
 
+    /**
+     * Switch the whole weight pipeline (correction, normalization and
+     * resampling) to log-weights. It should be set before booting the filter.
+     */
+    void setLogWeights(const bool status);
+
+    bool getLogWeights();
+
+    /**
+     * Run prediction, correction and resampling on num_threads threads, splitting the
+     * particles in cache-sized blocks. The pool is reused across steps.
+     * A value of 1 restores serial execution, while 0 uses all the available
+     * cores.
+     */
+    void setNumThreads(const unsigned int num_threads);
+
+    unsigned int getNumThreads();
+
 protected:
     ParticleFilter() noexcept;
 
@@ -36,10 +64,26 @@ protected:
 
     ParticleFilter& operator=(ParticleFilter&& pf) noexcept;
 
+    /**
+     * Normalize weights, either linear or log-weights according to
+     * getLogWeights(), on the thread pool when available, and return their
+     * statistics. See bfl::normalizeWeights().
+     */
+    WeightStatistics normalizeWeights(Eigen::Ref<Eigen::VectorXf> weights);
+
     std::unique_ptr<Initialization> initialization_;
     std::unique_ptr<PFPrediction>   prediction_;
     std::unique_ptr<PFCorrection>   correction_;
     std::unique_ptr<Resampling>     resampling_;
+
+    std::unique_ptr<ResamplingPolicy> resampling_policy_;
+
+    bool                            log_weights_ = false;
+
+    std::shared_ptr<ThreadPool>     thread_pool_;
+
+private:
+    Eigen::MatrixXd                 block_statistics_;
 };
 
 #endif /* PARTICLEFILTER_H */
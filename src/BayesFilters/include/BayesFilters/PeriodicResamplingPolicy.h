@@ -0,0 +1,30 @@
+#ifndef PERIODICRESAMPLINGPOLICY_H
+#define PERIODICRESAMPLINGPOLICY_H
+
+#include "ResamplingPolicy.h"
+
+namespace bfl {
+    class PeriodicResamplingPolicy;
+}
+
+
+/**
+ * Resample every period filtering steps, regardless of the weights. A
+ * period of 1 gives the bootstrap (SIR) particle filter.
+ */
+class bfl::PeriodicResamplingPolicy : public ResamplingPolicy
+{
+public:
+    PeriodicResamplingPolicy(unsigned int period) noexcept;
+
+    PeriodicResamplingPolicy() noexcept;
+
+    virtual ~PeriodicResamplingPolicy() noexcept;
+
+    bool resample(const WeightStatistics& statistics, const unsigned int step) override;
+
+protected:
+    unsigned int period_;
+};
+
+#endif /* PERIODICRESAMPLINGPOLICY_H */
@@ -0,0 +1,35 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+
+namespace bfl {
+    class Philox;
+}
+
+
+/**
+ * Philox4x32-10 counter-based random number generator [Salmon et al., 2011].
+ * Each 128-bit counter is mapped to 128 random bits by a keyed bijection, so
+ * that any element of a random stream is computed independently of the others
+ * and of the thread that needs it.
+ */
+class bfl::Philox
+{
+public:
+    Philox(const std::uint64_t seed) noexcept;
+
+    Philox() noexcept;
+
+    virtual ~Philox() noexcept;
+
+    /**
+     * Write in output the 4 random 32-bit words at counter (c_0, c_1).
+     */
+    void generate(const std::uint64_t c_0, const std::uint64_t c_1, std::uint32_t output[4]) const;
+
+private:
+    std::uint32_t key_[2];
+};
+
+#endif /* PHILOX_H */
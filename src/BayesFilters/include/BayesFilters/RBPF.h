@@ -0,0 +1,194 @@
+#ifndef RBPF_H
+#define RBPF_H
+
+#include "GaussianSampler.h"
+#include "ObservationModel.h"
+#include "ParticleFilter.h"
+#include "StateModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class RBPF;
+}
+
+
+/**
+ * Rao-Blackwellized (marginalized) particle filter for linear Gaussian
+ * models whose state splits in a sampled part and a linear part, e.g.
+ * positions and velocities of WhiteNoiseAcceleration observed by
+ * LinearSensor. Only the sampled part is represented by particles, while
+ * each particle carries the Kalman mean and covariance of the linear part
+ * conditioned on its trajectory.
+ *
+ * All the per-particle quantities are stored as structure of arrays, as in
+ * BatchKalmanFilter: the sampled states are a (particles x n_s) matrix, the
+ * linear means a (particles x n_l) matrix and the linear covariances a
+ * (particles x n_l^2) matrix. The Kalman updates of all the particles are
+ * then column operations over the particles.
+ *
+ * Resampling uses the resampling algorithm and policy set as for the other
+ * particle filters, while predictions and corrections are fixed by the model.
+ */
+class bfl::RBPF : public ParticleFilter
+{
+public:
+    RBPF() noexcept;
+
+    RBPF(RBPF&& rbpf) noexcept;
+
+    virtual ~RBPF() noexcept;
+
+    RBPF& operator=(RBPF&& rbpf) noexcept;
+
+    void setStateModel(std::unique_ptr<StateModel> state_model, const Eigen::Ref<const Eigen::MatrixXf>& F);
+
+    void setObservationModel(std::unique_ptr<ObservationModel> observation_model, const Eigen::Ref<const Eigen::MatrixXf>& H);
+
+    /**
+     * Indices of the state components that are marginalized by per-particle
+     * Kalman filters, the others are sampled.
+     */
+    void setLinearStates(const std::vector<int>& linear_states);
+
+    bool skip(const std::string& what_step, const bool status) override;
+
+    void initialization() override;
+
+    void filteringStep() override;
+
+    void getResult() override;
+
+    bool runCondition() override { return (measurement_driven_ || getFilteringStep() < simulation_time_); };
+
+    using FilteringAlgorithm::step;
+
+    /**
+     * Run one filtering step on the calling thread with the given
+     * measurement and return the weighted mean of the full state, before
+     * resampling. The returned vector is valid until the next step.
+     *
+     * As for the Kalman filters, the first call makes the filter
+     * measurement-driven, restarting it if it already ran simulated steps:
+     * no object and measurements are simulated, the number of steps is not
+     * bounded by the simulation length and the estimates written by
+     * getResult() are not stored. Steps without a measurement then reuse
+     * the last one.
+     */
+    const Eigen::VectorXf& step(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+protected:
+    /**
+     * Draw the sampled states from their predictive density given the linear
+     * means and covariances, then update the linear part with the sampled
+     * transition and predict it.
+     */
+    void predict();
+
+    /**
+     * Weight the particles by the marginal likelihood of measurement and
+     * update the linear part with it.
+     */
+    void correct(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+    void resample();
+
+    /**
+     * Kalman update of the linear part of all the particles given the
+     * innovations, the factors of their covariances computed by
+     * BatchKalmanFilter::choleskyColumns() and the cross covariances, all
+     * with measurement_size components.
+     */
+    void updateLinear(const int measurement_size);
+
+    /**
+     * Cache the partitions of the model matrices and their Kronecker products.
+     */
+    void partitionModel();
+
+    /**
+     * Weighted mean of the full state.
+     */
+    Eigen::VectorXf estimate();
+
+    static Eigen::MatrixXf submatrix(const Eigen::Ref<const Eigen::MatrixXf>& A, const std::vector<int>& rows, const std::vector<int>& cols);
+
+    static Eigen::RowVectorXf vectorize(const Eigen::Ref<const Eigen::MatrixXf>& A);
+
+    /**
+     * Copy row ancestors(j) of input into row j of output.
+     */
+    static void gatherRows(const Eigen::Ref<const Eigen::MatrixXf>& input, const Eigen::Ref<const VectorXl>& ancestors, Eigen::Ref<Eigen::MatrixXf> output);
+
+    unsigned int                      simulation_time_ = 100;
+    bool                              measurement_driven_ = false;
+    int                               num_particle_    = 900;
+    int                               surv_x_          = 1000;
+    int                               surv_y_          = 1000;
+
+    std::unique_ptr<StateModel>       state_model_;
+    std::unique_ptr<ObservationModel> observation_model_;
+
+    Eigen::MatrixXf                   F_;
+    Eigen::MatrixXf                   H_;
+
+    std::vector<int>                  sampled_states_;
+    std::vector<int>                  linear_states_;
+
+    Eigen::MatrixXf                   object_;
+    Eigen::MatrixXf                   measurement_;
+
+    Eigen::MatrixXf                   particles_;     /* Sampled states, (particles x n_s) */
+    Eigen::MatrixXf                   means_;         /* Linear means, (particles x n_l) */
+    Eigen::MatrixXf                   covariances_;   /* Linear covariances, (particles x n_l^2) */
+    Eigen::VectorXf                   weights_;
+
+    Eigen::MatrixXf                   result_state_;
+
+    Eigen::VectorXf                   estimate_;
+
+    GaussianSampler                   gaussian_sampler_;
+
+    /* Key of the sampling noise, incremented at every prediction. */
+    std::uint64_t                     noise_step_ = 0;
+
+    bool                              skip_prediction_ = false;
+    bool                              skip_correction_ = false;
+
+private:
+    /* Partitions of the model, s and l denoting the sampled and linear parts */
+    Eigen::MatrixXf                   F_ss_t_;
+    Eigen::MatrixXf                   F_sl_t_;
+    Eigen::MatrixXf                   F_ls_t_;
+    Eigen::MatrixXf                   F_ll_t_;        /* (F_ll - Q_ls Q_ss^-1 F_sl)' */
+    Eigen::MatrixXf                   G_t_;           /* (Q_ls Q_ss^-1)' */
+    Eigen::MatrixXf                   H_s_t_;
+    Eigen::MatrixXf                   H_l_t_;
+    Eigen::RowVectorXf                Q_ss_;
+    Eigen::RowVectorXf                Q_ll_;          /* vec(Q_ll - Q_ls Q_ss^-1 Q_sl) */
+    Eigen::RowVectorXf                R_;
+    Eigen::MatrixXf                   FF_sl_t_;       /* (F_sl kron F_sl)' */
+    Eigen::MatrixXf                   FI_sl_t_;       /* (F_sl kron I)' */
+    Eigen::MatrixXf                   FF_ll_t_;
+    Eigen::MatrixXf                   HH_l_t_;
+    Eigen::MatrixXf                   HI_l_t_;
+
+    /* Workspaces, in structure of arrays layout */
+    Eigen::MatrixXf                   innovations_;
+    Eigen::MatrixXf                   S_;
+    Eigen::MatrixXf                   PHt_;
+    Eigen::MatrixXf                   K_;
+    Eigen::MatrixXf                   pred_particles_;
+    Eigen::MatrixXf                   transitions_;
+    Eigen::MatrixXf                   noise_;
+    Eigen::MatrixXf                   tmp_;
+    Eigen::VectorXf                   log_likelihoods_;
+    VectorXl                          ancestors_;
+};
+
+#endif /* RBPF_H */
@@ -0,0 +1,36 @@
+#ifndef REJECTIONRESAMPLING_H
+#define REJECTIONRESAMPLING_H
+
+#include "Resampling.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class RejectionResampling;
+}
+
+
+/**
+ * Rejection resampling [Murray et al., 2016]: every ancestor is drawn by
+ * rejection sampling of uniformly proposed particle indices, accepting
+ * particle i with probability w_i / max(w). It is unbiased and needs no
+ * prefix sum, but its cost grows with max(w) / mean(w).
+ */
+class bfl::RejectionResampling : public Resampling
+{
+public:
+    RejectionResampling(unsigned int seed) noexcept;
+
+    RejectionResampling() noexcept;
+
+    RejectionResampling(RejectionResampling&& resampling) noexcept;
+
+    virtual ~RejectionResampling() noexcept;
+
+    RejectionResampling& operator=(RejectionResampling&& resampling) noexcept;
+
+
+    void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors) override;
+};
+
+#endif /* REJECTIONRESAMPLING_H */
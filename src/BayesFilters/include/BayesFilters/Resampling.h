@@ -1,12 +1,20 @@
 #ifndef RESAMPLING_H
 #define RESAMPLING_H
 
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include <Eigen/Dense>
 
 namespace bfl {
     class Resampling;
+    typedef Eigen::Matrix<std::int64_t, Eigen::Dynamic, 1> VectorXl;
 }
 
 
@@ -32,10 +40,79 @@ public:
     virtual void resample(const Eigen::Ref<const Eigen::MatrixXf>& cor_particles, const Eigen::Ref<const Eigen::VectorXf>& cor_weights,
                           Eigen::Ref<Eigen::MatrixXf> res_particles, Eigen::Ref<Eigen::VectorXf> res_weights, Eigen::Ref<Eigen::VectorXf> res_parents);
 
+    /**
+     * Draw res_ancestors.size() ancestor indices from the (possibly
+     * unnormalized) cor_weights by systematic resampling.
+     * The cumulative weights are accumulated in double precision by blocks,
+     * so that indices are exact for any number of particles and do not
+     * depend on the number of threads.
+     */
+    virtual void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors);
+
+    /**
+     * Copy column res_ancestors(j) of cor_particles into column j of
+     * res_particles. The two matrices must not alias.
+     */
+    void gather(const Eigen::Ref<const Eigen::MatrixXf>& cor_particles, const Eigen::Ref<const VectorXl>& res_ancestors, Eigen::Ref<Eigen::MatrixXf> res_particles);
+
     virtual float neff(const Eigen::Ref<const Eigen::VectorXf>& cor_weights);
 
+    /**
+     * When status is true, cor_weights are treated as (possibly unnormalized)
+     * log-weights and res_weights are returned as log-weights.
+     * Weights are exponentiated only while resampling.
+     */
+    void setLogWeights(const bool status);
+
+    bool getLogWeights();
+
+    /**
+     * Run the resampling on thread_pool. Passing nullptr restores serial
+     * execution.
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
+protected:
+    /**
+     * Fill cumulative_weights_ with the inclusive prefix sum of the linear
+     * weights and return their total. Log-weights are exponentiated relative
+     * to their maximum, which is stored in max_log_weight_.
+     */
+    double cumulativeWeights(const Eigen::Ref<const Eigen::VectorXf>& weights, const bool log_weights);
+
+    /**
+     * Linear weight of particle i on the same scale of the total returned by
+     * the last call to cumulativeWeights().
+     */
+    double linearWeight(const Eigen::Ref<const Eigen::VectorXf>& weights, const std::size_t i, const bool log_weights) const;
+
+    /**
+     * Return the first index i such that cumulative_weights_(i) >= u, starting
+     * the linear search from hint. The result is clamped to the last index.
+     */
+    std::int64_t searchCumulativeWeights(const double u, std::int64_t hint) const;
+
+    /**
+     * Draw one seed for each block of output particles from the resampling
+     * generator, so that blocks can sample independently of the thread that
+     * processes them.
+     */
+    std::vector<std::uint64_t> drawBlockSeeds(const std::size_t num_blocks);
+
+    std::shared_ptr<ThreadPool> thread_pool_;
+
+    Eigen::VectorXd             cumulative_weights_;
+
+    float                       max_log_weight_ = 0.0f;
+
+    VectorXl                    ancestors_;
+
 private:
     std::mt19937_64 generator_;
+
+    bool            log_weights_ = false;
+
+    Eigen::VectorXd block_sums_;
 };
 
 #endif /* RESAMPLING_H */
@@ -0,0 +1,64 @@
+#ifndef RESAMPLINGPOLICY_H
+#define RESAMPLINGPOLICY_H
+
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    struct WeightStatistics;
+    class ResamplingPolicy;
+}
+
+
+/**
+ * Statistics of a set of normalized particle weights, as computed by
+ * normalizeWeights().
+ */
+struct bfl::WeightStatistics
+{
+    std::size_t num_particles = 0;
+
+    /* Effective sample size 1 / sum(w_i^2). */
+    double      ess           = 0.0;
+
+    /* Shannon entropy -sum(w_i * log(w_i)), in nats. */
+    double      entropy       = 0.0;
+
+    /* Largest normalized weight. */
+    double      max_weight    = 0.0;
+};
+
+
+namespace bfl
+{
+    /**
+     * Normalize weights, either linear or log-weights, and return their
+     * statistics. Sum, sum of squares, entropy and maximum are accumulated
+     * together in a single pass over the weights, in blocks on thread_pool
+     * if not null. The per-block sums are stored in block_statistics, which is
+     * only resized when the number of blocks changes and can be reused across
+     * calls. If all the weights vanish, e.g. all the log-weights are -inf,
+     * uniform weights are set instead.
+     */
+    WeightStatistics normalizeWeights(Eigen::Ref<Eigen::VectorXf> weights, const bool log_weights,
+                                      const std::shared_ptr<ThreadPool>& thread_pool, Eigen::MatrixXd& block_statistics);
+}
+
+
+/**
+ * Decide whether the particle set should be resampled at a given filtering
+ * step, given the statistics of the normalized weights.
+ */
+class bfl::ResamplingPolicy
+{
+public:
+    virtual ~ResamplingPolicy() noexcept { };
+
+    virtual bool resample(const WeightStatistics& statistics, const unsigned int step) = 0;
+};
+
+#endif /* RESAMPLINGPOLICY_H */
@@ -1,6 +1,7 @@
 #ifndef RESAMPLINGWITHPRIOR_H
 #define RESAMPLINGWITHPRIOR_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -13,6 +14,11 @@ namespace bfl {
 }
 
 
+/**
+ * Replace the particles with the lowest weights, a prior_ratio fraction of
+ * them, with new particles drawn by init_model, and resample the remaining
+ * ones.
+ */
 class bfl::ResamplingWithPrior : public Resampling
 {
 public:
@@ -29,6 +35,12 @@ public:
     ResamplingWithPrior& operator=(ResamplingWithPrior&& resampling) noexcept;
 
 
+    /**
+     * The first prior_ratio fraction of res_particles is reinitialized in
+     * place by init_model and has parent -1, the remaining ones are resampled
+     * from the highest-weight particles. The highest weights are found by
+     * selection in linear time, without sorting nor copying the particles.
+     */
     void resample(const Eigen::Ref<const Eigen::MatrixXf>& pred_particles, const Eigen::Ref<const Eigen::VectorXf>& cor_weights,
                   Eigen::Ref<Eigen::MatrixXf> res_particles, Eigen::Ref<Eigen::VectorXf> res_weights, Eigen::Ref<Eigen::VectorXf> res_parents) override;
 
@@ -38,7 +50,9 @@ protected:
     double prior_ratio_ = 0.5;
 
 private:
-    std::vector<unsigned int> sort_indices(const Eigen::Ref<const Eigen::VectorXf>& vector);
+    std::vector<std::int64_t> indices_;
+
+    Eigen::VectorXf           high_weights_;
 };
 
 #endif /* RESAMPLINGWITHPRIOR_H */
@@ -0,0 +1,40 @@
+#ifndef RESIDUALRESAMPLING_H
+#define RESIDUALRESAMPLING_H
+
+#include "Resampling.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class ResidualResampling;
+}
+
+
+/**
+ * Residual resampling: particle i is first copied floor(M * w_i) times, the
+ * remaining ancestors are drawn by multinomial resampling of the residual
+ * weights. It has lower variance than multinomial resampling at equal cost.
+ */
+class bfl::ResidualResampling : public Resampling
+{
+public:
+    ResidualResampling(unsigned int seed) noexcept;
+
+    ResidualResampling() noexcept;
+
+    ResidualResampling(ResidualResampling&& resampling) noexcept;
+
+    virtual ~ResidualResampling() noexcept;
+
+    ResidualResampling& operator=(ResidualResampling&& resampling) noexcept;
+
+
+    void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors) override;
+
+private:
+    Eigen::VectorXf residual_weights_;
+
+    VectorXl        num_copies_;
+};
+
+#endif /* RESIDUALRESAMPLING_H */
@@ -1,12 +1,15 @@
 #ifndef SIS_H
 #define SIS_H
 
+#include "KLDSampling.h"
 #include "ParticleFilter.h"
 #include "PFCorrection.h"
 #include "PFPrediction.h"
 #include "Resampling.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <Eigen/Dense>
 
@@ -32,11 +35,58 @@ public:
 
     void getResult() override;
 
-    bool runCondition() override { return (getFilteringStep() < simulation_time_); };
+    bool runCondition() override { return (measurement_driven_ || getFilteringStep() < simulation_time_); };
+
+    using FilteringAlgorithm::step;
+
+    /**
+     * Run one filtering step on the calling thread with the given
+     * measurement and return the weighted mean of the corrected particles,
+     * before resampling. The returned vector is valid until the next step.
+     *
+     * The first call makes the filter measurement-driven, restarting it if
+     * it already ran simulated steps: initialization() no longer simulates
+     * the object and its measurements, the number of steps is not bounded
+     * by the simulation length and the particles and weights of each step
+     * are not copied for getResult(). Steps without a measurement then
+     * reuse the last one.
+     */
+    const Eigen::VectorXf& step(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+    /**
+     * Change the number of particles while the filter is running, without
+     * rebooting it. The next filtering step resamples the corrected particles
+     * to the requested number and resizes all the buffers accordingly.
+     */
+    void setNumParticles(const int num_particles);
+
+    int getNumParticles();
+
+    /**
+     * Adapt the number of particles at each filtering step by KLD-sampling.
+     * Passing nullptr keeps the current number of particles. May be called
+     * while the filter is running: the filtering thread takes the new object
+     * at the beginning of its next step.
+     */
+    void setKLDSampling(std::unique_ptr<KLDSampling> kld_sampling);
 
 protected:
+    /**
+     * Replace kld_sampling_ with the one passed to setKLDSampling(), if any.
+     * To be called by the filtering thread at the beginning of a step.
+     */
+    void updateKLDSampling();
+
+    /**
+     * Weighted mean of the corrected particles, into estimate_. To be called
+     * by the filtering step once the weights are normalized.
+     */
+    void updateEstimate();
+
     int                          simulation_time_;
+    bool                         measurement_driven_ = false;
     int                          num_particle_;
+    std::atomic<int>             num_particle_req_{0};
     int                          surv_x_;
     int                          surv_y_;
 
@@ -49,11 +99,25 @@ protected:
     Eigen::MatrixXf              cor_particle_;
     Eigen::VectorXf              cor_weight_;
 
+    /* Resampling writes here, then the buffers are swapped with the corrected ones. */
+    Eigen::MatrixXf              res_particle_;
+    Eigen::VectorXf              res_weight_;
+    Eigen::VectorXf              res_parent_;
+
     std::vector<Eigen::MatrixXf> result_pred_particle_;
     std::vector<Eigen::VectorXf> result_pred_weight_;
 
     std::vector<Eigen::MatrixXf> result_cor_particle_;
     std::vector<Eigen::VectorXf> result_cor_weight_;
+
+    std::unique_ptr<KLDSampling> kld_sampling_;
+
+    Eigen::VectorXf              estimate_;
+
+private:
+    std::mutex                   mtx_kld_sampling_;
+    std::unique_ptr<KLDSampling> kld_sampling_req_;
+    bool                         kld_sampling_changed_ = false;
 };
 
 #endif /* SIS_H */
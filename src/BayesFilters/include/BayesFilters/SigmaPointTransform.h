@@ -1,4 +1,134 @@
 #ifndef SIGMAPOINTTRANSFORM_H
 #define SIGMAPOINTTRANSFORM_H
 
+#include "ObservationModel.h"
+#include "StateModel.h"
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
+
+namespace bfl {
+    class SigmaPointTransform;
+}
+
+
+/**
+ * Deterministic sampling of a Gaussian distribution with weighted sigma
+ * points. All the sigma points are stored as columns of one matrix, so that
+ * they are pushed through StateModel::propagate() or
+ * ObservationModel::observe() with a single batched call.
+ */
+class bfl::SigmaPointTransform
+{
+public:
+    enum class Type
+    {
+        unscented,
+        cubature,
+        gauss_hermite
+    };
+
+
+    /**
+     * Unscented transform with parameters alpha, beta and kappa.
+     */
+    SigmaPointTransform(const unsigned int dim, const double alpha, const double beta, const double kappa) noexcept;
+
+    /**
+     * Unscented transform with alpha = 1, beta = 2, kappa = 0, third degree
+     * spherical-radial cubature rule, or Gauss-Hermite rule with 3 points per
+     * dimension.
+     */
+    SigmaPointTransform(const unsigned int dim, const Type type) noexcept;
+
+    /**
+     * Tensor product Gauss-Hermite rule with order points per dimension, i.e.
+     * order^dim sigma points.
+     */
+    SigmaPointTransform(const unsigned int dim, const unsigned int order) noexcept;
+
+    SigmaPointTransform(SigmaPointTransform&& transform) noexcept;
+
+    virtual ~SigmaPointTransform() noexcept;
+
+    SigmaPointTransform& operator=(SigmaPointTransform&& transform) noexcept;
+
+    Type getType() const;
+
+    unsigned int getDimension() const;
+
+    unsigned int getNumSigmaPoints() const;
+
+    const Eigen::VectorXf& getMeanWeights() const;
+
+    const Eigen::VectorXf& getCovarianceWeights() const;
+
+    /**
+     * Write the sigma points of N(mean, covariance) as columns of sigma_points.
+     */
+    void sigmaPoints(const Eigen::Ref<const Eigen::VectorXf>& mean, const Eigen::Ref<const Eigen::MatrixXf>& covariance, Eigen::Ref<Eigen::MatrixXf> sigma_points);
+
+    /**
+     * Weighted mean and covariance of the columns of points. The deviations
+     * from the mean are left in deviations.
+     */
+    void moments(const Eigen::Ref<const Eigen::MatrixXf>& points, Eigen::Ref<Eigen::VectorXf> mean, Eigen::Ref<Eigen::MatrixXf> covariance,
+                 Eigen::Ref<Eigen::MatrixXf> deviations);
+
+    /**
+     * Mean and covariance of the propagation through state_model of
+     * N(mean, covariance), with a single call to StateModel::propagate().
+     * The process noise is not added.
+     */
+    void propagate(StateModel& state_model, const Eigen::Ref<const Eigen::VectorXf>& mean, const Eigen::Ref<const Eigen::MatrixXf>& covariance,
+                   Eigen::Ref<Eigen::VectorXf> prop_mean, Eigen::Ref<Eigen::MatrixXf> prop_covariance);
+
+    /**
+     * Mean, covariance and cross covariance with the state of the observation
+     * through observation_model of N(mean, covariance), with a single call to
+     * ObservationModel::observe(). The measurement noise is not added.
+     */
+    void observe(ObservationModel& observation_model, const Eigen::Ref<const Eigen::VectorXf>& mean, const Eigen::Ref<const Eigen::MatrixXf>& covariance,
+                 Eigen::Ref<Eigen::VectorXf> obs_mean, Eigen::Ref<Eigen::MatrixXf> obs_covariance, Eigen::Ref<Eigen::MatrixXf> cross_covariance);
+
+    /**
+     * Sigma points of the last call to sigmaPoints(), propagate() or observe().
+     */
+    const Eigen::MatrixXf& getSigmaPoints() const;
+
+protected:
+    void unscentedPoints(const double alpha, const double beta, const double kappa);
+
+    void cubaturePoints();
+
+    void gaussHermitePoints(const unsigned int order);
+
+    Type                        type_;
+
+    unsigned int                dim_;
+
+    Eigen::MatrixXf             unit_points_;     /* Sigma points of N(0, I) */
+
+    Eigen::VectorXf             mean_weights_;
+
+    Eigen::VectorXf             covariance_weights_;
+
+private:
+    Eigen::LLT<Eigen::MatrixXf> covariance_llt_;
+
+    Eigen::MatrixXf             sigma_points_;
+
+    /* Workspaces, kept apart for propagate() and observe() so that
+     * alternating calls do not reallocate them. */
+    Eigen::MatrixXf             prop_points_;
+
+    Eigen::MatrixXf             prop_deviations_;
+
+    Eigen::MatrixXf             obs_points_;
+
+    Eigen::MatrixXf             obs_deviations_;
+
+    Eigen::MatrixXf             state_deviations_;
+};
+
 #endif /* SIGMAPOINTTRANSFORM_H */
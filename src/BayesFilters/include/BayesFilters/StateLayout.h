@@ -0,0 +1,70 @@
+#ifndef STATELAYOUT_H
+#define STATELAYOUT_H
+
+#include <vector>
+
+namespace bfl {
+    class StateLayout;
+}
+
+
+/**
+ * Description of how the components of a state vector are to be combined,
+ * as a sequence of contiguous blocks: linear components, unit vectors, angles
+ * in radians and unit quaternions.
+ */
+class bfl::StateLayout
+{
+public:
+    enum class BlockType
+    {
+        linear,
+        unit_vector,
+        angle,
+        quaternion
+    };
+
+
+    struct Block
+    {
+        BlockType    type;
+        unsigned int offset;
+        unsigned int size;
+    };
+
+
+    StateLayout() noexcept;
+
+    /**
+     * Layout made of a single block of linear_size linear components.
+     */
+    StateLayout(const unsigned int linear_size) noexcept;
+
+    StateLayout(const StateLayout& state_layout);
+
+    StateLayout(StateLayout&& state_layout) noexcept;
+
+    ~StateLayout() noexcept;
+
+    StateLayout& operator=(const StateLayout& state_layout);
+
+    StateLayout& operator=(StateLayout&& state_layout) noexcept;
+
+    /**
+     * Append a block of size components after the current ones. For angle
+     * blocks, size is the number of consecutive angles. Quaternion blocks must
+     * have size 4, stored as (w, x, y, z) or (x, y, z, w) alike.
+     */
+    bool addBlock(const BlockType type, const unsigned int size);
+
+    unsigned int getSize() const;
+
+    const std::vector<Block>& getBlocks() const;
+
+private:
+    unsigned int       size_ = 0;
+
+    std::vector<Block> blocks_;
+};
+
+#endif /* STATELAYOUT_H */
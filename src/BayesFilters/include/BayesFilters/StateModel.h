@@ -1,6 +1,8 @@
 #ifndef STATEMODEL_H
 #define STATEMODEL_H
 
+#include <cstdint>
+
 #include <Eigen/Dense>
 
 namespace bfl {
@@ -17,6 +19,17 @@ public:
 
     virtual void motion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> mot_states) = 0;
 
+    /**
+     * Like motion(), with the noise of column j keyed by (step, first_state + j)
+     * so that the result does not depend on how the states are split among
+     * threads. The default implementation ignores the key and calls motion().
+     */
+    virtual void keyedMotion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> mot_states,
+                             const std::uint64_t /* step */, const std::uint64_t /* first_state */)
+    {
+        motion(cur_states, mot_states);
+    }
+
     virtual Eigen::MatrixXf getNoiseSample(const int num) = 0;
 
     virtual Eigen::MatrixXf getNoiseCovarianceMatrix() = 0;
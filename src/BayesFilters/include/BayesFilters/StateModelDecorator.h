@@ -17,6 +17,9 @@ public:
 
     void motion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> mot_states) override;
 
+    void keyedMotion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> mot_states,
+                     const std::uint64_t step, const std::uint64_t first_state) override;
+
     Eigen::MatrixXf getNoiseSample(const int num) override;
 
     Eigen::MatrixXf getNoiseCovarianceMatrix() override;
@@ -0,0 +1,133 @@
+#ifndef STATISTICSEXTRACTION_H
+#define STATISTICSEXTRACTION_H
+
+#include "ThreadPool.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class StatisticsExtraction;
+}
+
+
+/**
+ * Weighted statistics of a particle set, complementing the point estimate of
+ * EstimatesExtraction with its uncertainty.
+ *
+ * Mean and covariance are accumulated in a single pass over contiguous blocks
+ * of particles, shifted by the first particle and summed in double precision
+ * for accuracy. Quantiles of each state component are found by weighted
+ * selection, i.e. a quickselect partitioning on values and summing weights,
+ * in expected linear time and without sorting. Credible intervals are the
+ * equal-tailed intervals between quantiles.
+ *
+ * Statistics treat all the components as linear, regardless of the state
+ * layout. Weights are linear, non-negative and not necessarily normalized.
+ */
+class bfl::StatisticsExtraction
+{
+public:
+    StatisticsExtraction() noexcept;
+
+    StatisticsExtraction(StatisticsExtraction&& statistics_extraction) noexcept;
+
+    StatisticsExtraction& operator=(StatisticsExtraction&& statistics_extraction) noexcept;
+
+    ~StatisticsExtraction() noexcept { };
+
+
+    enum class ExtractionMethod
+    {
+        mean,
+        covariance,
+        quantiles,
+        full
+    };
+
+
+    /**
+     * Statistics computed by extract(): the mean only, the mean and the
+     * covariance, the mean with quantiles and credible intervals, or all.
+     */
+    bool setMethod(const ExtractionMethod& extraction_method);
+
+    /**
+     * Probabilities of the quantiles, in [0, 1].
+     */
+    bool setQuantiles(const std::vector<double>& probabilities);
+
+    /**
+     * Probability, in (0, 1), covered by the credible intervals.
+     */
+    bool setCredibleLevel(const double level);
+
+    void setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
+    void extract(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights);
+
+    const Eigen::VectorXf& getMean() const;
+
+    const Eigen::MatrixXf& getCovariance() const;
+
+    /**
+     * Quantiles of each component, one column per probability in the order
+     * given to setQuantiles().
+     */
+    const Eigen::MatrixXf& getQuantiles() const;
+
+    /**
+     * Lower and upper bound of the credible interval of each component.
+     */
+    const Eigen::MatrixXf& getCredibleIntervals() const;
+
+    std::vector<std::string> getInfo() const;
+
+protected:
+    /**
+     * Weighted sums of the particles in [begin, end), shifted by shift:
+     * total weight, first moment and lower triangle of the second moment.
+     */
+    void accumulateMoments(const Eigen::Ref<const Eigen::MatrixXf>& particles, const Eigen::Ref<const Eigen::VectorXf>& weights,
+                           const Eigen::Ref<const Eigen::VectorXd>& shift, const std::size_t begin, const std::size_t end,
+                           double& weight_sum, Eigen::Ref<Eigen::VectorXd> first_moment, Eigen::Ref<Eigen::MatrixXd> second_moment) const;
+
+    /**
+     * Quantiles of one component, for the given increasing probabilities.
+     */
+    void componentQuantiles(const Eigen::Ref<const Eigen::RowVectorXf>& values, const Eigen::Ref<const Eigen::VectorXf>& weights,
+                            const std::vector<double>& probabilities, std::vector<std::pair<float, double>>& buffer, Eigen::Ref<Eigen::VectorXf> quantiles) const;
+
+    /**
+     * Smallest value whose cumulative weight in buffer[begin, end) reaches
+     * target. The range is partially partitioned such that the values
+     * before the returned position are smaller than the returned value.
+     */
+    static std::size_t weightedSelect(std::vector<std::pair<float, double>>& buffer, std::size_t begin, std::size_t end, double target, double& weight_before);
+
+    ExtractionMethod extraction_method_ = ExtractionMethod::covariance;
+
+    std::vector<double> probabilities_ = {0.5};
+
+    double credible_level_ = 0.95;
+
+    std::shared_ptr<ThreadPool> thread_pool_;
+
+    Eigen::VectorXf mean_;
+
+    Eigen::MatrixXf covariance_;
+
+    Eigen::MatrixXf quantiles_;
+
+    Eigen::MatrixXf credible_intervals_;
+
+private:
+    /* Selection buffer of (value, weight) pairs for each component */
+    std::vector<std::vector<std::pair<float, double>>> buffers_;
+};
+
+#endif /* STATISTICSEXTRACTION_H */
@@ -0,0 +1,34 @@
+#ifndef STRATIFIEDRESAMPLING_H
+#define STRATIFIEDRESAMPLING_H
+
+#include "Resampling.h"
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class StratifiedResampling;
+}
+
+
+/**
+ * Stratified resampling: the j-th ancestor is drawn by inverting the
+ * cumulative weights at (j + u_j) / M, with u_j independent uniform samples.
+ */
+class bfl::StratifiedResampling : public Resampling
+{
+public:
+    StratifiedResampling(unsigned int seed) noexcept;
+
+    StratifiedResampling() noexcept;
+
+    StratifiedResampling(StratifiedResampling&& resampling) noexcept;
+
+    virtual ~StratifiedResampling() noexcept;
+
+    StratifiedResampling& operator=(StratifiedResampling&& resampling) noexcept;
+
+
+    void ancestors(const Eigen::Ref<const Eigen::VectorXf>& cor_weights, Eigen::Ref<VectorXl> res_ancestors) override;
+};
+
+#endif /* STRATIFIEDRESAMPLING_H */
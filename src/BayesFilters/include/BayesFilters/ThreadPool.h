@@ -0,0 +1,89 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bfl {
+    class ThreadPool;
+}
+
+
+/**
+ * A fixed set of worker threads, reused across filtering steps, that process
+ * a range of particles split in contiguous blocks.
+ * The calling thread takes part in the computation, hence a pool of n threads
+ * spawns n-1 workers.
+ */
+class bfl::ThreadPool
+{
+public:
+    ThreadPool(const unsigned int num_threads);
+
+    ThreadPool();
+
+    ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool& thread_pool) = delete;
+
+    ThreadPool& operator=(const ThreadPool& thread_pool) = delete;
+
+
+    /**
+     * Call kernel(begin, end) on consecutive blocks of at most block_size
+     * elements covering [0, size), and return once all blocks are processed.
+     * Exceptions thrown by kernel are rethrown in the calling thread.
+     */
+    void parallelFor(const std::size_t size, const std::size_t block_size, const std::function<void(const std::size_t, const std::size_t)>& kernel);
+
+    unsigned int getNumThreads() const;
+
+    /**
+     * Call kernel(begin, end) on the same blocks as parallelFor(), on
+     * thread_pool if not null and on the calling thread otherwise. The blocks
+     * do not depend on the thread pool, hence neither do results reduced
+     * per block.
+     */
+    static void forEachBlock(const std::shared_ptr<ThreadPool>& thread_pool, const std::size_t size, const std::size_t block_size,
+                             const std::function<void(const std::size_t, const std::size_t)>& kernel);
+
+    /**
+     * Number of particles per block such that a block of particles with the
+     * given number of rows, and its output, fits in the per-core cache.
+     */
+    static std::size_t getBlockSize(const std::size_t rows);
+
+private:
+    void workerLoop();
+
+    void processBlocks();
+
+
+    std::vector<std::thread> workers_;
+
+    std::mutex               mtx_parallel_for_;
+
+    std::mutex               mtx_job_;
+    std::condition_variable  cv_job_;
+    std::condition_variable  cv_done_;
+
+    unsigned long            job_id_      = 0;
+    bool                     teardown_    = false;
+    unsigned int             busy_workers_ = 0;
+
+    const std::function<void(const std::size_t, const std::size_t)>* kernel_ = nullptr;
+    std::size_t              size_        = 0;
+    std::size_t              block_size_  = 1;
+    std::atomic<std::size_t> next_block_;
+
+    std::exception_ptr       exception_;
+};
+
+#endif /* THREADPOOL_H */
@@ -2,24 +2,120 @@
 #define UNSCENTEDKALMANFILTER_H
 
 #include "FilteringAlgorithm.h"
+#include "ObservationModel.h"
+#include "SigmaPointTransform.h"
+#include "StateModel.h"
+
+#include <memory>
+#include <string>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
 
 namespace bfl {
     class UnscentedKalmanFilter;
 }
 
 
+/**
+ * Sigma-point Kalman filter. The prediction pushes all the sigma points
+ * through StateModel::propagate() at once, the correction through
+ * ObservationModel::observe() at once; the noise covariance matrices of the
+ * models are added to the transformed covariances. The sigma-point rule is
+ * the unscented transform by default and can be replaced with
+ * setSigmaPointTransform().
+ */
 class bfl::UnscentedKalmanFilter: public FilteringAlgorithm
 {
 public:
-    UnscentedKalmanFilter();
+    UnscentedKalmanFilter() noexcept;
+
+    UnscentedKalmanFilter(UnscentedKalmanFilter&& ukf) noexcept;
 
     virtual ~UnscentedKalmanFilter() noexcept;
 
+    UnscentedKalmanFilter& operator=(UnscentedKalmanFilter&& ukf) noexcept;
+
+    void setStateModel(std::unique_ptr<StateModel> state_model);
+
+    void setObservationModel(std::unique_ptr<ObservationModel> observation_model);
+
+    void setSigmaPointTransform(std::unique_ptr<SigmaPointTransform> sigma_point_transform);
+
+    /**
+     * Initial state mean and covariance. Defaults to a zero mean and a
+     * covariance of 1000 times the identity.
+     */
+    void setInitialState(const Eigen::Ref<const Eigen::VectorXf>& mean, const Eigen::Ref<const Eigen::MatrixXf>& covariance);
+
+    bool skip(const std::string& what_step, const bool status) override;
+
     void initialization() override;
 
     void filteringStep() override;
 
     void getResult() override;
+
+    bool runCondition() override { return (measurement_driven_ || getFilteringStep() < simulation_time_); };
+
+    using FilteringAlgorithm::step;
+
+    /**
+     * Run one filtering step on the calling thread with the given
+     * measurement and return the corrected state mean. The returned vector
+     * is valid until the next step.
+     *
+     * The first call makes the filter measurement-driven, restarting it if
+     * it already ran simulated steps: initialization() no longer simulates
+     * the object and its measurements, the number of steps is not bounded
+     * by the simulation length and the per-step results written by
+     * getResult() are not stored. Steps without a measurement, e.g. by
+     * run(), then reuse the last one.
+     */
+    const Eigen::VectorXf& step(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+protected:
+    void predict();
+
+    void correct(const Eigen::Ref<const Eigen::VectorXf>& measurement);
+
+    unsigned int                         simulation_time_ = 100;
+
+    bool                                 measurement_driven_ = false;
+
+    std::unique_ptr<StateModel>          state_model_;
+    std::unique_ptr<ObservationModel>    observation_model_;
+    std::unique_ptr<SigmaPointTransform> sigma_point_transform_;
+
+    Eigen::MatrixXf                      Q_;          /* Process noise covariance matrix, cached at initialization */
+    Eigen::MatrixXf                      R_;          /* Measurement noise covariance matrix, cached at initialization */
+
+    Eigen::VectorXf                      x_0_;
+    Eigen::MatrixXf                      P_0_;
+
+    Eigen::MatrixXf                      object_;
+    Eigen::MatrixXf                      measurement_;
+
+    Eigen::VectorXf                      x_;          /* State mean */
+    Eigen::MatrixXf                      P_;          /* State covariance matrix */
+
+    Eigen::MatrixXf                      result_x_;
+    Eigen::MatrixXf                      result_P_;
+
+    bool                                 skip_prediction_ = false;
+    bool                                 skip_correction_ = false;
+
+private:
+    /* Workspaces */
+    Eigen::VectorXf                      x_pred_;
+    Eigen::MatrixXf                      P_pred_;
+    Eigen::VectorXf                      z_pred_;
+    Eigen::MatrixXf                      S_;
+    Eigen::LLT<Eigen::MatrixXf>          S_llt_;
+    Eigen::MatrixXf                      C_;          /* State-measurement cross covariance */
+    Eigen::MatrixXf                      Kt_;
+    Eigen::VectorXf                      y_;
+    Eigen::MatrixXf                      KS_;
 };
 
 #endif /* UNSCENTEDKALMANFILTER_H */
@@ -6,6 +6,8 @@
 #include <memory>
 #include <random>
 
+#include <Eigen/Cholesky>
+
 namespace bfl {
     class UpdateParticles;
 }
@@ -25,6 +27,10 @@ public:
 
     double likelihood(const Eigen::Ref<const Eigen::VectorXf>& innovation) override;
 
+    void likelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_weights) override;
+
+    void logLikelihoods(const Eigen::Ref<const Eigen::MatrixXf>& innovations, Eigen::Ref<Eigen::VectorXf> cor_log_weights) override;
+
     virtual ObservationModel& getObservationModel() override;
 
     virtual void setObservationModel(std::unique_ptr<ObservationModel> observation_model) override;
@@ -33,7 +39,14 @@ protected:
     void correctStep(const Eigen::Ref<const Eigen::MatrixXf>& pred_states, const Eigen::Ref<const Eigen::VectorXf>& pred_weights, const Eigen::Ref<const Eigen::MatrixXf>& measurements,
                      Eigen::Ref<Eigen::MatrixXf> cor_states, Eigen::Ref<Eigen::VectorXf> cor_weights) override;
 
+    /* Factorize the observation noise covariance and return the log of the Gaussian normalization factor */
+    float factorizeNoiseCovariance();
+
     std::unique_ptr<ObservationModel> observation_model_;
+
+    Eigen::LLT<Eigen::MatrixXf>       noise_covariance_llt_;
+    Eigen::MatrixXf                   innovations_;
+    Eigen::MatrixXf                   whitened_innovations_;
 };
 
 #endif /* UPDATEPARTICLES_H */
@@ -1,9 +1,10 @@
 #ifndef WHITENOISEACCELERATION_H
 #define WHITENOISEACCELERATION_H
 
-#include <functional>
-#include <random>
+#include <cstdint>
+#include <mutex>
 
+#include "GaussianSampler.h"
 #include "StateModel.h"
 
 namespace bfl {
@@ -34,6 +35,9 @@ public:
 
     void motion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> prop_states) override;
 
+    void keyedMotion(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> prop_states,
+                     const std::uint64_t step, const std::uint64_t first_state) override;
+
     Eigen::MatrixXf getNoiseSample(const int num) override;
 
     Eigen::MatrixXf getNoiseCovarianceMatrix() override;
@@ -41,15 +45,24 @@ public:
     bool setProperty(const std::string& property) override { return false; };
 
 protected:
+    /**
+     * Fused motion kernel: for each block of columns, while it is in cache,
+     * apply F_, draw the noise and add it through sqrt_Q_, without
+     * temporaries as large as the states. The noise is keyed by
+     * (step, first_state + j) when keyed is true, otherwise it is drawn from
+     * the sequential generator, which the caller must lock.
+     */
+    void motionBlocks(const Eigen::Ref<const Eigen::MatrixXf>& cur_states, Eigen::Ref<Eigen::MatrixXf> prop_states,
+                      const bool keyed, const std::uint64_t step, const std::uint64_t first_state);
+
     float                           T_;                /* Sampling interval */
     Eigen::Matrix4f                 F_;                /* State transition matrix */
     Eigen::Matrix4f                 Q_;                /* Process white noise convariance matrix */
     float                           tilde_q_;          /* Power spectral density [length]^2/[time]^3 */
 
     Eigen::Matrix4f                 sqrt_Q_;           /* Square root matrix of the process white noise convariance matrix */
-    std::mt19937_64                 generator_;
-    std::normal_distribution<float> distribution_;
-    std::function<float()>          gauss_rnd_sample_; /* Random number generator from a Normal distribution */
+    GaussianSampler                 gaussian_sampler_; /* Block generator of standard normal samples */
+    std::mutex                      mtx_noise_;        /* Serializes noise sampling when particles are processed in parallel */
 };
 
 #endif /* WHITENOISEACCELERATION_H */
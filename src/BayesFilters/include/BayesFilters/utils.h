@@ -0,0 +1,35 @@
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <cmath>
+#include <limits>
+
+#include <Eigen/Dense>
+
+namespace bfl
+{
+namespace utils
+{
+
+/**
+ * Return log(sum(exp(data))) computed in a numerically stable way, i.e.
+ * without exponentiating values that may underflow or overflow.
+ * If all the elements of data are -inf, -inf is returned.
+ */
+template<typename Derived>
+typename Derived::Scalar log_sum_exp(const Eigen::DenseBase<Derived>& data)
+{
+    typedef typename Derived::Scalar Scalar;
+
+    const Scalar max = data.maxCoeff();
+
+    if (!std::isfinite(max))
+        return max;
+
+    return max + std::log((data.derived().array() - max).exp().sum());
+}
+
+}
+}
+
+#endif /* UTILS_H */
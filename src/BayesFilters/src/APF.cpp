@@ -0,0 +1,117 @@
+#include "BayesFilters/APF.h"
+
+#include <cmath>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+APF::APF() noexcept :
+    auxiliary_function_(new AuxiliaryFunction()) { }
+
+
+APF::APF(APF&& apf) noexcept :
+    SIS(std::move(apf)),
+    auxiliary_function_(std::move(apf.auxiliary_function_)) { }
+
+
+APF::~APF() noexcept { }
+
+
+APF& APF::operator=(APF&& apf) noexcept
+{
+    SIS::operator=(std::move(apf));
+
+    auxiliary_function_ = std::move(apf.auxiliary_function_);
+
+    return *this;
+}
+
+
+void APF::setAuxiliaryFunction(std::unique_ptr<AuxiliaryFunction> auxiliary_function)
+{
+    auxiliary_function_ = std::move(auxiliary_function);
+}
+
+
+void APF::filteringStep()
+{
+    unsigned int k = getFilteringStep();
+    const Ref<const VectorXf> measurement = measurement_.col(measurement_driven_ ? 0 : k);
+
+    updateKLDSampling();
+
+    if (k != 0)
+    {
+        /* First stage: resample according to the weights adjusted by the look-ahead */
+        aux_log_weights_.resize(num_particle_);
+        auxiliary_function_->logWeights(*prediction_, *correction_, cor_particle_, measurement, aux_log_weights_);
+
+        if (log_weights_)
+            first_stage_weights_ = cor_weight_ + aux_log_weights_;
+        else
+            first_stage_weights_ = cor_weight_.array() * (aux_log_weights_.array() - aux_log_weights_.maxCoeff()).exp();
+
+        /* The first stage draws the requested number of particles, if any */
+        const int num_particle_req = num_particle_req_;
+        const int num_res_particle = num_particle_req > 0 ? num_particle_req : num_particle_;
+
+        res_particle_.resize(cor_particle_.rows(), num_res_particle);
+        res_weight_.resize(num_res_particle);
+
+        ancestors_.resize(num_res_particle);
+        resampling_->ancestors(first_stage_weights_, ancestors_);
+        resampling_->gather(cor_particle_, ancestors_, res_particle_);
+
+        res_aux_log_weights_.resize(num_res_particle);
+        for (int i = 0; i < num_res_particle; ++i)
+            res_aux_log_weights_(i) = aux_log_weights_(ancestors_(i));
+
+        if (num_res_particle != num_particle_)
+        {
+            num_particle_ = num_res_particle;
+
+            pred_particle_.resize(res_particle_.rows(), num_particle_);
+            pred_weight_.resize(num_particle_);
+
+            cor_particle_.resize(res_particle_.rows(), num_particle_);
+            cor_weight_.resize(num_particle_);
+        }
+
+        if (log_weights_)
+            res_weight_.setConstant(-std::log(static_cast<float>(num_particle_)));
+        else
+            res_weight_.setConstant(1.0 / num_particle_);
+
+        prediction_->setMeasurement(measurement);
+        prediction_->predict(res_particle_, res_weight_,
+                             pred_particle_, pred_weight_);
+
+        /* Second stage: remove the look-ahead adjustment of the ancestors */
+        if (log_weights_)
+            pred_weight_ -= res_aux_log_weights_;
+        else
+            pred_weight_.array() *= (res_aux_log_weights_.minCoeff() - res_aux_log_weights_.array()).exp();
+    }
+
+    correction_->correct(pred_particle_, pred_weight_, measurement,
+                         cor_particle_, cor_weight_);
+
+    normalizeWeights(cor_weight_);
+
+    updateEstimate();
+
+    if (kld_sampling_)
+        num_particle_req_ = kld_sampling_->numParticles(cor_particle_);
+
+
+    if (!measurement_driven_)
+    {
+        result_pred_particle_[k] = pred_particle_;
+        result_pred_weight_  [k] = pred_weight_;
+
+        result_cor_particle_[k]  = cor_particle_;
+        result_cor_weight_  [k]  = cor_weight_;
+    }
+}
@@ -1 +1,40 @@
 #include "BayesFilters/AuxiliaryFunction.h"
+
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+AuxiliaryFunction::AuxiliaryFunction() noexcept { }
+
+
+AuxiliaryFunction::AuxiliaryFunction(AuxiliaryFunction&& auxiliary_function) noexcept :
+    point_estimates_(std::move(auxiliary_function.point_estimates_)),
+    innovations_(std::move(auxiliary_function.innovations_)) { }
+
+
+AuxiliaryFunction::~AuxiliaryFunction() noexcept { }
+
+
+AuxiliaryFunction& AuxiliaryFunction::operator=(AuxiliaryFunction&& auxiliary_function) noexcept
+{
+    point_estimates_ = std::move(auxiliary_function.point_estimates_);
+    innovations_     = std::move(auxiliary_function.innovations_);
+
+    return *this;
+}
+
+
+void AuxiliaryFunction::logWeights(PFPrediction& prediction, PFCorrection& correction,
+                                   const Ref<const MatrixXf>& prev_states, const Ref<const MatrixXf>& measurements,
+                                   Ref<VectorXf> log_weights)
+{
+    point_estimates_.resize(prev_states.rows(), prev_states.cols());
+    prediction.getStateModel().propagate(prev_states, point_estimates_);
+
+    innovations_.resize(measurements.rows(), prev_states.cols());
+    correction.innovation(point_estimates_, measurements, innovations_);
+
+    correction.logLikelihoods(innovations_, log_weights);
+}
@@ -0,0 +1,257 @@
+#include "BayesFilters/BatchKalmanFilter.h"
+
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+BatchKalmanFilter::BatchKalmanFilter(std::unique_ptr<StateModel> state_model, const Ref<const MatrixXf>& F,
+                                     std::unique_ptr<ObservationModel> observation_model, const Ref<const MatrixXf>& H) noexcept :
+    state_model_(std::move(state_model)),
+    observation_model_(std::move(observation_model)),
+    F_(F),
+    H_(H)
+{
+    cacheModelMatrices();
+}
+
+
+BatchKalmanFilter::BatchKalmanFilter(BatchKalmanFilter&& batch_kf) noexcept :
+    state_model_(std::move(batch_kf.state_model_)),
+    observation_model_(std::move(batch_kf.observation_model_)),
+    F_(std::move(batch_kf.F_)),
+    H_(std::move(batch_kf.H_)),
+    Q_(std::move(batch_kf.Q_)),
+    R_(std::move(batch_kf.R_)),
+    FF_t_(std::move(batch_kf.FF_t_)),
+    HH_t_(std::move(batch_kf.HH_t_)),
+    HI_t_(std::move(batch_kf.HI_t_)),
+    means_(std::move(batch_kf.means_)),
+    covariances_(std::move(batch_kf.covariances_)) { }
+
+
+BatchKalmanFilter::~BatchKalmanFilter() noexcept { }
+
+
+BatchKalmanFilter& BatchKalmanFilter::operator=(BatchKalmanFilter&& batch_kf) noexcept
+{
+    state_model_       = std::move(batch_kf.state_model_);
+    observation_model_ = std::move(batch_kf.observation_model_);
+
+    F_    = std::move(batch_kf.F_);
+    H_    = std::move(batch_kf.H_);
+    Q_    = std::move(batch_kf.Q_);
+    R_    = std::move(batch_kf.R_);
+    FF_t_ = std::move(batch_kf.FF_t_);
+    HH_t_ = std::move(batch_kf.HH_t_);
+    HI_t_ = std::move(batch_kf.HI_t_);
+
+    means_       = std::move(batch_kf.means_);
+    covariances_ = std::move(batch_kf.covariances_);
+
+    return *this;
+}
+
+
+void BatchKalmanFilter::initialize(const Ref<const MatrixXf>& means, const Ref<const MatrixXf>& covariances)
+{
+    means_       = means.transpose();
+    covariances_ = covariances.transpose();
+}
+
+
+void BatchKalmanFilter::predict()
+{
+    /* x = F x, i.e. X = X F' with one track per row */
+    means_tmp_.noalias() = means_ * F_.transpose();
+    means_.swap(means_tmp_);
+
+    /* vec(F P F' + Q) = (F kron F) vec(P) + vec(Q) */
+    covariances_tmp_.noalias() = covariances_ * FF_t_;
+    covariances_tmp_.rowwise() += Q_;
+    covariances_.swap(covariances_tmp_);
+}
+
+
+void BatchKalmanFilter::correct(const Ref<const MatrixXf>& measurements)
+{
+    mask_.setOnes(means_.rows());
+
+    correctTracks(measurements, mask_);
+}
+
+
+void BatchKalmanFilter::correct(const Ref<const MatrixXf>& measurements, const Ref<const Array<bool, Dynamic, 1>>& mask)
+{
+    mask_ = mask.cast<float>();
+
+    correctTracks(measurements, mask_);
+}
+
+
+std::size_t BatchKalmanFilter::getNumTracks() const
+{
+    return means_.rows();
+}
+
+
+const MatrixXf& BatchKalmanFilter::getMeans() const
+{
+    return means_;
+}
+
+
+const MatrixXf& BatchKalmanFilter::getCovariances() const
+{
+    return covariances_;
+}
+
+
+VectorXf BatchKalmanFilter::getMean(const std::size_t track) const
+{
+    return means_.row(track).transpose();
+}
+
+
+MatrixXf BatchKalmanFilter::getCovariance(const std::size_t track) const
+{
+    const int state_size = F_.rows();
+
+    MatrixXf covariance(state_size, state_size);
+    Map<RowVectorXf>(covariance.data(), covariance.size()) = covariances_.row(track);
+
+    return covariance;
+}
+
+
+StateModel& BatchKalmanFilter::getStateModel()
+{
+    return *state_model_;
+}
+
+
+ObservationModel& BatchKalmanFilter::getObservationModel()
+{
+    return *observation_model_;
+}
+
+
+void BatchKalmanFilter::cacheModelMatrices()
+{
+    const int n = F_.rows();
+
+    const MatrixXf Q = state_model_->getNoiseCovarianceMatrix();
+    const MatrixXf R = observation_model_->getNoiseCovarianceMatrix();
+
+    Q_ = Map<const RowVectorXf>(Q.data(), Q.size());
+    R_ = Map<const RowVectorXf>(R.data(), R.size());
+
+    FF_t_ = kronecker(F_, F_).transpose();
+    HH_t_ = kronecker(H_, H_).transpose();
+    HI_t_ = kronecker(H_, MatrixXf::Identity(n, n)).transpose();
+}
+
+
+void BatchKalmanFilter::correctTracks(const Ref<const MatrixXf>& measurements, const Ref<const ArrayXf>& mask)
+{
+    const int n = F_.rows();
+    const int m = H_.rows();
+
+    /* Innovations y = z - H x */
+    innovations_.noalias() = measurements.transpose();
+    innovations_.noalias() -= means_ * H_.transpose();
+
+    /* Tracks without a measurement get a zero innovation, whatever their (possibly NaN) measurement */
+    for (int a = 0; a < m; ++a)
+        innovations_.col(a) = (mask > 0.0f).select(innovations_.col(a).array(), 0.0f);
+
+    /* Innovation covariances S = H P H' + R and cross covariances P H' */
+    S_.noalias() = covariances_ * HH_t_;
+    S_.rowwise() += R_;
+
+    PHt_.noalias() = covariances_ * HI_t_;
+
+    /* Cholesky factorization S = L L' of all the tracks, in place in the lower part of S */
+    choleskyColumns(S_, m);
+
+    /* Gain K = P H' S^-1 */
+    K_ = PHt_;
+    rightSolveColumns(S_, m, K_, n);
+
+    /* Tracks without a measurement get a zero gain */
+    K_.array().colwise() *= mask;
+
+    /* x = x + K y */
+    for (int i = 0; i < n; ++i)
+        for (int a = 0; a < m; ++a)
+            means_.col(i).array() += K_.col(i + n * a).array() * innovations_.col(a).array();
+
+    /* P = P - K S K' = P - K (P H')' */
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+            for (int a = 0; a < m; ++a)
+                covariances_.col(i + n * j).array() -= K_.col(i + n * a).array() * PHt_.col(j + n * a).array();
+}
+
+
+MatrixXf BatchKalmanFilter::kronecker(const Ref<const MatrixXf>& A, const Ref<const MatrixXf>& B)
+{
+    MatrixXf AB(A.rows() * B.rows(), A.cols() * B.cols());
+    for (int i = 0; i < A.rows(); ++i)
+        for (int j = 0; j < A.cols(); ++j)
+            AB.block(i * B.rows(), j * B.cols(), B.rows(), B.cols()) = A(i, j) * B;
+
+    return AB;
+}
+
+
+void BatchKalmanFilter::choleskyColumns(Ref<MatrixXf> S, const int m)
+{
+    for (int b = 0; b < m; ++b)
+    {
+        for (int k = 0; k < b; ++k)
+            S.col(b + m * b).array() -= S.col(b + m * k).array().square();
+        S.col(b + m * b) = S.col(b + m * b).cwiseSqrt();
+
+        for (int a = b + 1; a < m; ++a)
+        {
+            for (int k = 0; k < b; ++k)
+                S.col(a + m * b).array() -= S.col(a + m * k).array() * S.col(b + m * k).array();
+            S.col(a + m * b).array() /= S.col(b + m * b).array();
+        }
+    }
+}
+
+
+void BatchKalmanFilter::lowerSolveColumns(const Ref<const MatrixXf>& L, const int m, Ref<MatrixXf> x)
+{
+    for (int a = 0; a < m; ++a)
+    {
+        for (int k = 0; k < a; ++k)
+            x.col(a).array() -= L.col(a + m * k).array() * x.col(k).array();
+        x.col(a).array() /= L.col(a + m * a).array();
+    }
+}
+
+
+void BatchKalmanFilter::rightSolveColumns(const Ref<const MatrixXf>& L, const int m, Ref<MatrixXf> X, const int n)
+{
+    /* Solve L L' X(i, :)' = X(i, :)' for each row i */
+    for (int i = 0; i < n; ++i)
+    {
+        for (int a = 0; a < m; ++a)
+        {
+            for (int k = 0; k < a; ++k)
+                X.col(i + n * a).array() -= L.col(a + m * k).array() * X.col(i + n * k).array();
+            X.col(i + n * a).array() /= L.col(a + m * a).array();
+        }
+
+        for (int a = m - 1; a >= 0; --a)
+        {
+            for (int k = a + 1; k < m; ++k)
+                X.col(i + n * a).array() -= L.col(k + m * a).array() * X.col(i + n * k).array();
+            X.col(i + n * a).array() /= L.col(a + m * a).array();
+        }
+    }
+}
@@ -10,7 +10,8 @@ DrawParticles::DrawParticles() noexcept { }
 
 
 DrawParticles::DrawParticles(DrawParticles&& draw_particles) noexcept :
-    PFPrediction(std::move(draw_particles)) { };
+    PFPrediction(std::move(draw_particles)),
+    noise_step_(draw_particles.noise_step_) { };
 
 
 DrawParticles::~DrawParticles() noexcept { }
@@ -19,8 +20,21 @@ DrawParticles::~DrawParticles() noexcept { }
 void DrawParticles::predictStep(const Ref<const MatrixXf>& prev_states, const Ref<const VectorXf>& prev_weights,
                                 Ref<MatrixXf> pred_states, Ref<VectorXf> pred_weights)
 {
-    state_model_->motion(prev_states, pred_states);
-    
+    /* The noise is keyed by step and particle index, hence the result does not depend on the number of threads. */
+    if (thread_pool_)
+    {
+        thread_pool_->parallelFor(prev_states.cols(), ThreadPool::getBlockSize(prev_states.rows()),
+                                  [&](const std::size_t begin, const std::size_t end)
+                                  {
+                                      state_model_->keyedMotion(prev_states.middleCols(begin, end - begin), pred_states.middleCols(begin, end - begin),
+                                                                noise_step_, begin);
+                                  });
+    }
+    else
+        state_model_->keyedMotion(prev_states, pred_states, noise_step_, 0);
+
+    ++noise_step_;
+
     pred_weights = prev_weights;
 }
 
@@ -34,3 +48,9 @@ void DrawParticles::setStateModel(std::unique_ptr<StateModel> state_model)
 {
     state_model_ = std::move(state_model);
 }
+
+
+void DrawParticles::resetNoise()
+{
+    noise_step_ = 0;
+}
@@ -0,0 +1,20 @@
+#include "BayesFilters/ESSResamplingPolicy.h"
+
+using namespace bfl;
+
+
+ESSResamplingPolicy::ESSResamplingPolicy(double ratio) noexcept :
+    ratio_(ratio) { }
+
+
+ESSResamplingPolicy::ESSResamplingPolicy() noexcept :
+    ESSResamplingPolicy(1.0 / 3.0) { }
+
+
+ESSResamplingPolicy::~ESSResamplingPolicy() noexcept { }
+
+
+bool ESSResamplingPolicy::resample(const WeightStatistics& statistics, const unsigned int /* step */)
+{
+    return statistics.ess < ratio_ * statistics.num_particles;
+}
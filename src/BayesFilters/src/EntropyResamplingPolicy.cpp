@@ -0,0 +1,22 @@
+#include "BayesFilters/EntropyResamplingPolicy.h"
+
+#include <cmath>
+
+using namespace bfl;
+
+
+EntropyResamplingPolicy::EntropyResamplingPolicy(double ratio) noexcept :
+    ratio_(ratio) { }
+
+
+EntropyResamplingPolicy::EntropyResamplingPolicy() noexcept :
+    EntropyResamplingPolicy(0.5) { }
+
+
+EntropyResamplingPolicy::~EntropyResamplingPolicy() noexcept { }
+
+
+bool EntropyResamplingPolicy::resample(const WeightStatistics& statistics, const unsigned int /* step */)
+{
+    return statistics.entropy < ratio_ * std::log(static_cast<double>(statistics.num_particles));
+}
@@ -1,15 +1,32 @@
 #include "BayesFilters/EstimatesExtraction.h"
 
+#include <cmath>
+#include <stdexcept>
+
+#include <Eigen/SVD>
+
 using namespace bfl;
 using namespace Eigen;
 
 
+EstimatesExtraction::EstimatesExtraction() noexcept :
+    default_state_layout_(true)
+{
+    state_layout_.addBlock(StateLayout::BlockType::linear,      3);
+    state_layout_.addBlock(StateLayout::BlockType::unit_vector, 3);
+    state_layout_.addBlock(StateLayout::BlockType::angle,       1);
+}
+
+
+EstimatesExtraction::EstimatesExtraction(const StateLayout& state_layout) noexcept :
+    state_layout_(state_layout) { }
+
+
 EstimatesExtraction::EstimatesExtraction(EstimatesExtraction&& estimate_extraction) noexcept :
     extraction_method_(estimate_extraction.extraction_method_),
-    hist_buffer_(std::move(estimate_extraction.hist_buffer_)),
-    sm_weights_(std::move(estimate_extraction.sm_weights_)),
-    wm_weights_(std::move(estimate_extraction.wm_weights_)),
-    em_weights_(std::move(estimate_extraction.em_weights_))
+    state_layout_(std::move(estimate_extraction.state_layout_)),
+    default_state_layout_(estimate_extraction.default_state_layout_),
+    hist_buffer_(std::move(estimate_extraction.hist_buffer_))
 {
     estimate_extraction.extraction_method_ = ExtractionMethod::emode;
 }
@@ -22,11 +39,10 @@ EstimatesExtraction& EstimatesExtraction::operator=(EstimatesExtraction&& estima
         extraction_method_ = estimate_extraction.extraction_method_;
         estimate_extraction.extraction_method_ = ExtractionMethod::emode;
 
-        hist_buffer_ = std::move(estimate_extraction.hist_buffer_);
+        state_layout_ = std::move(estimate_extraction.state_layout_);
+        default_state_layout_ = estimate_extraction.default_state_layout_;
 
-        sm_weights_ = std::move(estimate_extraction.sm_weights_);
-        wm_weights_ = std::move(estimate_extraction.wm_weights_);
-        em_weights_ = std::move(estimate_extraction.em_weights_);
+        hist_buffer_ = std::move(estimate_extraction.hist_buffer_);
     }
 
     return *this;
@@ -50,9 +66,31 @@ bool EstimatesExtraction::setMobileAverageWindowSize(const int window)
 }
 
 
+void EstimatesExtraction::setStateLayout(const StateLayout& state_layout)
+{
+    state_layout_ = state_layout;
+    default_state_layout_ = false;
+}
+
+
+const StateLayout& EstimatesExtraction::getStateLayout() const
+{
+    return state_layout_;
+}
+
+
 VectorXf EstimatesExtraction::extract(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights)
 {
-    VectorXf out_particle(7);
+    if (static_cast<Index>(state_layout_.getSize()) != particles.rows())
+    {
+        if (!default_state_layout_)
+            throw std::runtime_error("ERROR::ESTIMATESEXTRACTION::EXTRACT\nERROR:\n\tParticle size does not match the state layout size.");
+
+        state_layout_ = StateLayout(particles.rows());
+        hist_buffer_.clear();
+    }
+
+    VectorXf out_particle;
     switch (extraction_method_)
     {
         case ExtractionMethod::mean :
@@ -119,27 +157,65 @@ std::vector<std::string> EstimatesExtraction::getInfo() const
 
 VectorXf EstimatesExtraction::mean(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights) const
 {
-    VectorXf out_particle = VectorXf::Zero(7);
-    float    s_ang        = 0;
-    float    c_ang        = 0;
+    VectorXf out_particle(particles.rows());
 
-    for (int i = 0; i < particles.cols(); ++i)
+    for (const StateLayout::Block& block : state_layout_.getBlocks())
     {
-        out_particle.head<3>()        += weights(i) * particles.col(i).head<3>();
-        out_particle.middleRows<3>(3) += weights(i) * particles.col(i).middleRows<3>(3);
-
-        s_ang += weights(i) * std::sin(particles(6, i));
-        c_ang += weights(i) * std::cos(particles(6, i));
+        const auto block_particles = particles.middleRows(block.offset, block.size);
+        auto       block_mean      = out_particle.segment(block.offset, block.size);
+
+        switch (block.type)
+        {
+            case StateLayout::BlockType::linear :
+            {
+                block_mean.noalias() = block_particles * weights;
+                break;
+            }
+
+            case StateLayout::BlockType::unit_vector :
+            {
+                block_mean.noalias() = block_particles * weights;
+
+                float versor_norm = block_mean.norm();
+                if (versor_norm >= 0.99)
+                    block_mean /= versor_norm;
+                else
+                    block_mean = mode(particles, weights).segment(block.offset, block.size);
+
+                break;
+            }
+
+            case StateLayout::BlockType::angle :
+            {
+                /* Sines and cosines of whole rows are evaluated by the vectorized Eigen kernels */
+                const VectorXf s_ang = block_particles.array().sin().matrix() * weights;
+                const VectorXf c_ang = block_particles.array().cos().matrix() * weights;
+
+                block_mean = s_ang.binaryExpr(c_ang, [](const float s, const float c) { return std::atan2(s, c); });
+                break;
+            }
+
+            case StateLayout::BlockType::quaternion :
+            {
+                /* Principal eigenvector of sum(w q q'), invariant to the sign of each q.
+                 * The scatter matrix is symmetric positive semidefinite, hence it is
+                 * the first left singular vector. */
+                const Matrix4f scatter = block_particles * weights.asDiagonal() * block_particles.transpose();
+
+                JacobiSVD<Matrix4f> svd(scatter, ComputeFullU);
+                block_mean = svd.matrixU().col(0);
+
+                /* Keep the sign of the quaternion with the largest weight */
+                MatrixXf::Index max_weight;
+                weights.maxCoeff(&max_weight);
+                if (block_mean.dot(block_particles.col(max_weight)) < 0)
+                    block_mean = -block_mean;
+
+                break;
+            }
+        }
     }
 
-    float versor_norm = out_particle.middleRows<3>(3).norm();
-    if (versor_norm >= 0.99)
-        out_particle.middleRows<3>(3) /= versor_norm;
-    else
-        out_particle.middleRows<3>(3) = mode(particles, weights).middleRows<3>(3);
-
-    out_particle(6) = std::atan2(s_ang, c_ang);
-
     return out_particle;
 }
 
@@ -154,6 +230,115 @@ VectorXf EstimatesExtraction::mode(const Ref<const MatrixXf>& particles, const R
 }
 
 
+VectorXf EstimatesExtraction::liftEstimate(const Ref<const VectorXf>& estimate) const
+{
+    unsigned int lifted_size = 0;
+    for (const StateLayout::Block& block : state_layout_.getBlocks())
+    {
+        if (block.type == StateLayout::BlockType::angle)
+            lifted_size += 2 * block.size;
+        else if (block.type == StateLayout::BlockType::quaternion)
+            lifted_size += 16;
+        else
+            lifted_size += block.size;
+    }
+
+    VectorXf lifted(lifted_size);
+
+    unsigned int offset = 0;
+    for (const StateLayout::Block& block : state_layout_.getBlocks())
+    {
+        const auto block_estimate = estimate.segment(block.offset, block.size);
+
+        switch (block.type)
+        {
+            case StateLayout::BlockType::linear :
+            case StateLayout::BlockType::unit_vector :
+            {
+                lifted.segment(offset, block.size) = block_estimate;
+                offset += block.size;
+                break;
+            }
+
+            case StateLayout::BlockType::angle :
+            {
+                lifted.segment(offset, block.size)              = block_estimate.array().sin();
+                lifted.segment(offset + block.size, block.size) = block_estimate.array().cos();
+                offset += 2 * block.size;
+                break;
+            }
+
+            case StateLayout::BlockType::quaternion :
+            {
+                Map<Matrix4f>(lifted.data() + offset) = block_estimate * block_estimate.transpose();
+                offset += 16;
+                break;
+            }
+        }
+    }
+
+    return lifted;
+}
+
+
+VectorXf EstimatesExtraction::lowerEstimate(const Ref<const VectorXf>& lifted_average, const Ref<const VectorXf>& last_estimate) const
+{
+    VectorXf out_particle(state_layout_.getSize());
+
+    unsigned int offset = 0;
+    for (const StateLayout::Block& block : state_layout_.getBlocks())
+    {
+        auto block_mean = out_particle.segment(block.offset, block.size);
+
+        switch (block.type)
+        {
+            case StateLayout::BlockType::linear :
+            {
+                block_mean = lifted_average.segment(offset, block.size);
+                offset += block.size;
+                break;
+            }
+
+            case StateLayout::BlockType::unit_vector :
+            {
+                block_mean = lifted_average.segment(offset, block.size);
+                offset += block.size;
+
+                float versor_norm = block_mean.norm();
+                if (versor_norm >= 0.99)
+                    block_mean /= versor_norm;
+                else
+                    block_mean = last_estimate.segment(block.offset, block.size);
+
+                break;
+            }
+
+            case StateLayout::BlockType::angle :
+            {
+                block_mean = lifted_average.segment(offset, block.size).binaryExpr(lifted_average.segment(offset + block.size, block.size),
+                                                                                   [](const float s, const float c) { return std::atan2(s, c); });
+                offset += 2 * block.size;
+                break;
+            }
+
+            case StateLayout::BlockType::quaternion :
+            {
+                JacobiSVD<Matrix4f> svd(Map<const Matrix4f>(lifted_average.data() + offset), ComputeFullU);
+                block_mean = svd.matrixU().col(0);
+                offset += 16;
+
+                if (block_mean.dot(last_estimate.segment(block.offset, block.size)) < 0)
+                    block_mean = -block_mean;
+
+                break;
+            }
+        }
+    }
+
+    return out_particle;
+}
+
+
 VectorXf EstimatesExtraction::simpleAverage(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights,
                                             const Statistics& base_est_ext)
 {
@@ -164,14 +349,10 @@ VectorXf EstimatesExtraction::simpleAverage(const Ref<const MatrixXf>& particles
         cur_estimates = mode(particles, weights);
 
 
-    hist_buffer_.addElement(cur_estimates);
-
-    MatrixXf history = hist_buffer_.getHistoryBuffer();
-    if (sm_weights_.size() != history.cols())
-        sm_weights_ = VectorXf::Ones(history.cols()) / history.cols();
+    hist_buffer_.addElement(liftEstimate(cur_estimates));
 
 
-    return mean(history, sm_weights_);
+    return lowerEstimate(hist_buffer_.getSimpleAverage(), cur_estimates);
 }
 
 
@@ -185,20 +366,10 @@ VectorXf EstimatesExtraction::weightedAverage(const Ref<const MatrixXf>& particl
         cur_estimates = mode(particles, weights);
 
 
-    hist_buffer_.addElement(cur_estimates);
+    hist_buffer_.addElement(liftEstimate(cur_estimates));
 
-    MatrixXf history = hist_buffer_.getHistoryBuffer();
-    if (wm_weights_.size() != history.cols())
-    {
-        wm_weights_.resize(history.cols());
-        for (unsigned int i = 0; i < history.cols(); ++i)
-            wm_weights_(i) = history.cols() - i;
 
-        wm_weights_ /= wm_weights_.sum();
-    }
-
-
-    return mean(history, wm_weights_);
+    return lowerEstimate(hist_buffer_.getLinearAverage(), cur_estimates);
 }
 
 
@@ -212,17 +383,8 @@ VectorXf EstimatesExtraction::exponentialAverage(const Ref<const MatrixXf>& part
         cur_estimates = mode(particles, weights);
 
 
-    hist_buffer_.addElement(cur_estimates);
+    hist_buffer_.addElement(liftEstimate(cur_estimates));
 
-    MatrixXf history = hist_buffer_.getHistoryBuffer();
-    if (em_weights_.size() != history.cols())
-    {
-        em_weights_.resize(history.cols());
-        for (unsigned int i = 0; i < history.cols(); ++i)
-            em_weights_(i) = std::exp(-(static_cast<double>(i) / history.cols()));
-
-        em_weights_ /= em_weights_.sum();
-    }
 
-    return mean(history, em_weights_);
+    return lowerEstimate(hist_buffer_.getExponentialAverage(), cur_estimates);
 }
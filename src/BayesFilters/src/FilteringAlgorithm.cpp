@@ -1,10 +1,23 @@
 #include "BayesFilters/FilteringAlgorithm.h"
 
+#include <exception>
 #include <iostream>
 
 using namespace bfl;
 
 
+FilteringAlgorithm::~FilteringAlgorithm() noexcept
+{
+    if (executor_)
+    {
+        std::unique_lock<std::mutex> lk(mtx_run_);
+
+        teardown_ = true;
+        cv_task_done_.wait(lk, [this]{ return !task_scheduled_; });
+    }
+}
+
+
 bool FilteringAlgorithm::boot()
 {
     try
@@ -23,17 +36,53 @@ bool FilteringAlgorithm::boot()
 }
 
 
+bool FilteringAlgorithm::boot(std::shared_ptr<FilteringExecutor> executor)
+{
+    if (!executor)
+    {
+        std::cerr << "ERROR::FILTERINGALGORITHM::BOOT" << std::endl;
+        std::cerr << "ERROR::LOG:\n\tinvalid executor." << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_run_);
+
+    executor_               = std::move(executor);
+    task_done_              = false;
+    task_scheduled_         = false;
+    initialization_pending_ = true;
+
+    /* As at the beginning of filteringRecursion(), the first task then waits
+     * for run() or teardown(). */
+    reset_          = false;
+    filtering_step_ = 0;
+
+    if (run_ || teardown_)
+        submitTask();
+
+    return true;
+}
+
+
 void FilteringAlgorithm::run()
 {
     std::lock_guard<std::mutex> lk(mtx_run_);
     run_ = true;
     cv_run_.notify_one();
+
+    if (executor_ && !task_scheduled_ && !task_done_)
+        submitTask();
 }
 
 
 bool FilteringAlgorithm::wait()
 {
-    if (filtering_thread_.joinable())
+    if (executor_)
+    {
+        std::unique_lock<std::mutex> lk(mtx_run_);
+        cv_task_done_.wait(lk, [this]{ return task_done_; });
+    }
+    else if (filtering_thread_.joinable())
     {
         try
         {
@@ -76,6 +125,14 @@ bool FilteringAlgorithm::teardown()
 {
     teardown_ = true;
 
+    /* A filter waiting for run() on the executor has no thread to wake up,
+     * hence its recursion is resumed to close. */
+    {
+        std::lock_guard<std::mutex> lk(mtx_run_);
+        if (executor_ && !task_scheduled_ && !task_done_)
+            submitTask();
+    }
+
     std::cout << "INFO::FILTERINGALGORITHM::TEARDOWN" << std::endl;
     std::cout << "INFO::LOG: filtering thread instructed to close." << std::endl;
 
@@ -83,6 +140,19 @@ bool FilteringAlgorithm::teardown()
 }
 
 
+bool FilteringAlgorithm::step()
+{
+    if (!prepareStep())
+        return false;
+
+    filteringStep();
+
+    ++filtering_step_;
+
+    return true;
+}
+
+
 unsigned int FilteringAlgorithm::getFilteringStep()
 {
     return filtering_step_;
@@ -129,3 +199,86 @@ void FilteringAlgorithm::filteringRecursion()
 
     run_ = false;
 }
+
+
+bool FilteringAlgorithm::prepareStep()
+{
+    if (reset_)
+    {
+        reset_                  = false;
+        filtering_step_         = 0;
+        initialization_pending_ = true;
+    }
+
+    if (initialization_pending_)
+    {
+        initialization();
+
+        initialization_pending_ = false;
+    }
+
+    return runCondition() && !teardown_;
+}
+
+
+void FilteringAlgorithm::filteringTask()
+{
+    /* Once torn down, e.g. by the destructor, the derived class is not called anymore. */
+    try
+    {
+        if (initialization_pending_ && !teardown_)
+        {
+            initialization();
+
+            initialization_pending_ = false;
+        }
+
+        if (!teardown_ && !reset_ && runCondition())
+        {
+            filteringStep();
+
+            ++filtering_step_;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR::FILTERINGALGORITHM::FILTERINGTASK" << std::endl;
+        std::cerr << "ERROR::LOG:\n\t" << e.what() << std::endl;
+        teardown_ = true;
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_run_);
+
+    /* Yield to the other tasks of the executor between filtering steps. */
+    if (!teardown_ && !reset_ && runCondition())
+    {
+        submitTask();
+        return;
+    }
+
+    if (!teardown_ && (run_ || reset_) && runCondition())
+    {
+        reset_                  = false;
+        filtering_step_         = 0;
+        initialization_pending_ = true;
+
+        /* Wait for run() or teardown() without holding a thread. */
+        task_scheduled_ = false;
+        if (run_ || teardown_)
+            submitTask();
+
+        return;
+    }
+
+    run_            = false;
+    task_scheduled_ = false;
+    task_done_      = true;
+    cv_task_done_.notify_all();
+}
+
+
+void FilteringAlgorithm::submitTask()
+{
+    task_scheduled_ = true;
+    executor_->submit([this]{ this->filteringTask(); });
+}
@@ -0,0 +1,135 @@
+#include "BayesFilters/FilteringExecutor.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+using namespace bfl;
+
+
+thread_local FilteringExecutor* FilteringExecutor::local_executor_ = nullptr;
+
+thread_local unsigned int FilteringExecutor::local_index_ = 0;
+
+
+FilteringExecutor::FilteringExecutor(const unsigned int num_threads) :
+    next_queue_(0)
+{
+    const unsigned int num_workers = num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned int i = 0; i < num_workers; ++i)
+        queues_.emplace_back(new TaskQueue());
+
+    for (unsigned int i = 0; i < num_workers; ++i)
+        workers_.emplace_back(&FilteringExecutor::workerLoop, this, i);
+}
+
+
+FilteringExecutor::FilteringExecutor() :
+    FilteringExecutor(0) { }
+
+
+FilteringExecutor::~FilteringExecutor() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_idle_);
+        teardown_ = true;
+    }
+    cv_idle_.notify_all();
+
+    for (std::thread& worker : workers_)
+        if (worker.joinable())
+            worker.join();
+}
+
+
+void FilteringExecutor::submit(std::function<void()> task)
+{
+    const unsigned int index = (local_executor_ == this) ? local_index_ : next_queue_++ % queues_.size();
+
+    {
+        std::lock_guard<std::mutex> lk(queues_[index]->mtx);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_idle_);
+        ++num_tasks_;
+    }
+    cv_idle_.notify_one();
+}
+
+
+unsigned int FilteringExecutor::getNumThreads() const
+{
+    return static_cast<unsigned int>(workers_.size());
+}
+
+
+void FilteringExecutor::workerLoop(const unsigned int index)
+{
+    local_executor_ = this;
+    local_index_    = index;
+
+    std::function<void()> task;
+
+    while (true)
+    {
+        if (popTask(index, task))
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "ERROR::FILTERINGEXECUTOR::WORKERLOOP" << std::endl;
+                std::cerr << "ERROR::LOG:\n\t" << e.what() << std::endl;
+            }
+
+            task = nullptr;
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(mtx_idle_);
+        cv_idle_.wait(lk, [this]{ return teardown_ || num_tasks_ > 0; });
+
+        if (teardown_)
+            return;
+    }
+}
+
+
+bool FilteringExecutor::popTask(const unsigned int index, std::function<void()>& task)
+{
+    const unsigned int num_queues = static_cast<unsigned int>(queues_.size());
+
+    /* Own queue from the front, then the other queues from the back. */
+    for (unsigned int i = 0; i < num_queues; ++i)
+    {
+        TaskQueue& queue = *queues_[(index + i) % num_queues];
+
+        std::lock_guard<std::mutex> lk(queue.mtx);
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0)
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+
+        std::lock_guard<std::mutex> lk_idle(mtx_idle_);
+        --num_tasks_;
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,236 @@
+#include "BayesFilters/GaussianProposalPrediction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+GaussianProposalPrediction::GaussianProposalPrediction(const std::uint64_t seed) noexcept :
+    gaussian_sampler_(seed) { }
+
+
+GaussianProposalPrediction::GaussianProposalPrediction() noexcept :
+    GaussianProposalPrediction(1) { }
+
+
+GaussianProposalPrediction::GaussianProposalPrediction(GaussianProposalPrediction&& prediction) noexcept :
+    PFPrediction(std::move(prediction)),
+    state_model_(std::move(prediction.state_model_)),
+    observation_model_(std::move(prediction.observation_model_)),
+    sigma_point_transform_(std::move(prediction.sigma_point_transform_)),
+    measurement_(std::move(prediction.measurement_)),
+    gaussian_sampler_(std::move(prediction.gaussian_sampler_)),
+    noise_step_(prediction.noise_step_) { }
+
+
+GaussianProposalPrediction::~GaussianProposalPrediction() noexcept { }
+
+
+StateModel& GaussianProposalPrediction::getStateModel()
+{
+    return *state_model_;
+}
+
+
+void GaussianProposalPrediction::setStateModel(std::unique_ptr<StateModel> state_model)
+{
+    state_model_ = std::move(state_model);
+}
+
+
+ObservationModel& GaussianProposalPrediction::getObservationModel()
+{
+    return *observation_model_;
+}
+
+
+void GaussianProposalPrediction::setObservationModel(std::unique_ptr<ObservationModel> observation_model)
+{
+    observation_model_ = std::move(observation_model);
+}
+
+
+void GaussianProposalPrediction::setSigmaPointTransform(std::unique_ptr<SigmaPointTransform> sigma_point_transform)
+{
+    sigma_point_transform_ = std::move(sigma_point_transform);
+}
+
+
+void GaussianProposalPrediction::setMeasurement(const Ref<const VectorXf>& measurement)
+{
+    measurement_ = measurement;
+}
+
+
+void GaussianProposalPrediction::resetNoise()
+{
+    noise_step_ = 0;
+}
+
+
+void GaussianProposalPrediction::predictStep(const Ref<const MatrixXf>& prev_states, const Ref<const VectorXf>& prev_weights,
+                                             Ref<MatrixXf> pred_states, Ref<VectorXf> pred_weights)
+{
+    const int state_size = prev_states.rows();
+
+    Q_ = state_model_->getNoiseCovarianceMatrix();
+    Q_llt_.compute(Q_);
+    Q_log_det_ = 2.0f * Q_llt_.matrixLLT().diagonal().array().log().sum();
+
+    if (measurement_.size() > 0)
+    {
+        R_ = observation_model_->getNoiseCovarianceMatrix();
+
+        if (!sigma_point_transform_ || sigma_point_transform_->getDimension() != static_cast<unsigned int>(state_size))
+            sigma_point_transform_ = std::unique_ptr<SigmaPointTransform>(new SigmaPointTransform(state_size, SigmaPointTransform::Type::unscented));
+
+        sigma_offsets_.resize(state_size, sigma_point_transform_->getNumSigmaPoints());
+        sigma_point_transform_->sigmaPoints(VectorXf::Zero(state_size), Q_, sigma_offsets_);
+
+        weighted_deviations_ = (sigma_offsets_.colwise() - sigma_offsets_ * sigma_point_transform_->getMeanWeights()) * sigma_point_transform_->getCovarianceWeights().asDiagonal();
+    }
+
+    log_ratios_.resize(prev_states.cols());
+
+    /* Workspaces, including the LLT decompositions computed in place, only allocate when the sizes change. */
+    const std::size_t num_particles    = prev_states.cols();
+    const std::size_t block_size       = ThreadPool::getBlockSize(state_size);
+    const int         block_particles  = std::min(block_size, num_particles);
+    const int         measurement_size = measurement_.size();
+    const int         num_sigma_points = measurement_size > 0 ? sigma_offsets_.cols() : 0;
+
+    block_workspaces_.resize((num_particles + block_size - 1) / block_size);
+    for (BlockWorkspace& workspace : block_workspaces_)
+    {
+        workspace.prior_means.resize(state_size, block_particles);
+        workspace.noise.resize(state_size, block_particles);
+        workspace.sigma_points.resize(state_size, block_particles * num_sigma_points);
+        workspace.observations.resize(measurement_size, block_particles * num_sigma_points);
+        workspace.pred_measurement.resize(measurement_size);
+        workspace.innovation.resize(measurement_size);
+        workspace.deviations.resize(measurement_size, num_sigma_points);
+        workspace.weighted_deviations.resize(measurement_size, num_sigma_points);
+        workspace.S.resize(measurement_size, measurement_size);
+        workspace.C.resize(state_size, measurement_size);
+        workspace.Kt.resize(measurement_size, state_size);
+        workspace.covariance.resize(state_size, state_size);
+        workspace.mean.resize(state_size);
+        workspace.residual.resize(state_size);
+    }
+
+    /* The noise is keyed by step and particle index, hence the result does not depend on the number of threads. */
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 proposalBlock(prev_states.middleCols(begin, end - begin), pred_states.middleCols(begin, end - begin),
+                                               log_ratios_.segment(begin, end - begin), begin, block_workspaces_[begin / block_size]);
+                             });
+
+    ++noise_step_;
+
+    if (getLogWeights())
+        pred_weights = prev_weights + log_ratios_;
+    else
+    {
+        /* The increments are rescaled by their maximum, which the weight normalization cancels out. */
+        const float max_log_ratio = log_ratios_.maxCoeff();
+        pred_weights = prev_weights.array() * (log_ratios_.array() - max_log_ratio).exp();
+    }
+
+    measurement_.resize(0);
+}
+
+
+void GaussianProposalPrediction::proposalBlock(const Ref<const MatrixXf>& prev_states, Ref<MatrixXf> pred_states,
+                                               Ref<VectorXf> log_ratios, const std::size_t first_particle, BlockWorkspace& workspace)
+{
+    const int num_particles = prev_states.cols();
+
+    /* Means of the state transition density, f(x_k-1) */
+    auto prior_means = workspace.prior_means.leftCols(num_particles);
+    state_model_->propagate(prev_states, prior_means);
+
+    auto noise = workspace.noise.leftCols(num_particles);
+    gaussian_sampler_.fill(noise, noise_step_, first_particle);
+
+    if (measurement_.size() == 0)
+    {
+        pred_states.noalias() = prior_means;
+        pred_states.noalias() += Q_llt_.matrixL() * noise;
+        log_ratios.setZero();
+
+        return;
+    }
+
+    const int num_sigma_points = sigma_offsets_.cols();
+    const VectorXf& mean_weights = sigma_point_transform_->getMeanWeights();
+
+    /* Sigma points of all the particles of the block, observed at once */
+    auto sigma_points = workspace.sigma_points.leftCols(num_particles * num_sigma_points);
+    for (int i = 0; i < num_particles; ++i)
+        sigma_points.middleCols(i * num_sigma_points, num_sigma_points) = sigma_offsets_.colwise() + prior_means.col(i);
+
+    auto observations = workspace.observations.leftCols(num_particles * num_sigma_points);
+    observation_model_->observe(sigma_points, observations);
+
+    VectorXf& pred_measurement = workspace.pred_measurement;
+    VectorXf& innovation       = workspace.innovation;
+    MatrixXf& deviations       = workspace.deviations;
+    MatrixXf& S                = workspace.S;
+    MatrixXf& C                = workspace.C;
+    MatrixXf& Kt               = workspace.Kt;
+    MatrixXf& covariance       = workspace.covariance;
+    VectorXf& mean             = workspace.mean;
+    VectorXf& residual         = workspace.residual;
+
+    for (int i = 0; i < num_particles; ++i)
+    {
+        const auto particle_observations = observations.middleCols(i * num_sigma_points, num_sigma_points);
+
+        pred_measurement.noalias() = particle_observations * mean_weights;
+        deviations = particle_observations.colwise() - pred_measurement;
+
+        /* S = Cov[h(x)] + R, C = Cov[x, h(x)] */
+        workspace.weighted_deviations = deviations * sigma_point_transform_->getCovarianceWeights().asDiagonal();
+        S.noalias() = workspace.weighted_deviations * deviations.transpose();
+        S += R_;
+        C.noalias() = weighted_deviations_ * deviations.transpose();
+
+        /* Proposal N(f(x_k-1) + K (z - h), Q - K S K'), with K = C S^-1 */
+        workspace.S_llt.compute(S);
+        Kt = C.transpose();
+        workspace.S_llt.solveInPlace(Kt);
+
+        innovation = measurement_ - pred_measurement;
+        mean = prior_means.col(i);
+        mean.noalias() += Kt.transpose() * innovation;
+
+        covariance = Q_;
+        covariance.noalias() -= C * Kt;
+        workspace.covariance_llt.compute(covariance);
+
+        if (workspace.covariance_llt.info() != Success)
+        {
+            /* Numerically degenerate proposal, fall back to the state transition density. */
+            pred_states.col(i) = prior_means.col(i);
+            pred_states.col(i).noalias() += Q_llt_.matrixL() * noise.col(i);
+            log_ratios(i) = 0.0f;
+
+            continue;
+        }
+
+        pred_states.col(i) = mean;
+        pred_states.col(i).noalias() += workspace.covariance_llt.matrixL() * noise.col(i);
+
+        /* log p(x_k | x_k-1) - log q(x_k | x_k-1, z_k) */
+        residual = pred_states.col(i) - prior_means.col(i);
+        Q_llt_.matrixL().solveInPlace(residual);
+
+        const float log_det = 2.0f * workspace.covariance_llt.matrixLLT().diagonal().array().log().sum();
+
+        log_ratios(i) = 0.5f * (noise.col(i).squaredNorm() - residual.squaredNorm() + log_det - Q_log_det_);
+    }
+}
@@ -0,0 +1,182 @@
+#include "BayesFilters/GaussianSampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+constexpr std::size_t GaussianSampler::num_lanes;
+
+
+GaussianSampler::GaussianSampler(const std::uint64_t seed) noexcept
+{
+    this->seed(seed);
+}
+
+
+GaussianSampler::GaussianSampler() noexcept :
+    GaussianSampler(1) { }
+
+
+GaussianSampler::~GaussianSampler() noexcept { }
+
+
+void GaussianSampler::seed(const std::uint64_t seed)
+{
+    philox_ = Philox(seed);
+
+    /* Lane states are initialized with splitmix64, as suggested for the xoshiro family. */
+    std::uint64_t x = seed;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        for (std::size_t l = 0; l < num_lanes; ++l)
+        {
+            std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+            state_[i][l] = z ^ (z >> 31);
+        }
+    }
+}
+
+
+void GaussianSampler::fill(Ref<MatrixXf> samples)
+{
+    const std::size_t block = 2 * num_lanes;
+
+    /* Contiguous matrices are filled at once, otherwise column by column. */
+    const bool contiguous = samples.outerStride() == samples.rows();
+    const std::size_t num_segments = contiguous ? 1 : samples.cols();
+    const std::size_t segment_size = contiguous ? samples.size() : samples.rows();
+
+    float tail[block];
+    for (std::size_t s = 0; s < num_segments; ++s)
+    {
+        float* data = contiguous ? samples.data() : samples.col(s).data();
+
+        std::size_t i = 0;
+        for (; i + block <= segment_size; i += block)
+            fillBlock(data + i);
+
+        if (i < segment_size)
+        {
+            fillBlock(tail);
+            std::copy(tail, tail + (segment_size - i), data + i);
+        }
+    }
+}
+
+
+void GaussianSampler::fill(Ref<MatrixXf> samples, const std::uint64_t stream, const std::uint64_t first_column) const
+{
+    constexpr std::size_t num_pairs = 64;
+    typedef Array<float, num_pairs, 1> ArrayPf;
+
+    const std::size_t rows       = samples.rows();
+    const std::size_t num_blocks = (rows + 3) / 4;
+
+    /* Uniform pairs are buffered with their destination, then transformed at once. */
+    ArrayPf     u_1 = ArrayPf::Ones();
+    ArrayPf     u_2 = ArrayPf::Zero();
+    std::size_t dest_row[num_pairs];
+    std::size_t dest_col[num_pairs];
+    std::size_t num_buffered = 0;
+
+    auto transform = [&]()
+    {
+        const ArrayPf radius = (-2.0f * u_1.log()).sqrt();
+        const ArrayPf theta  = static_cast<float>(2.0 * M_PI) * u_2;
+
+        const ArrayPf samples_cos = radius * theta.cos();
+        const ArrayPf samples_sin = radius * theta.sin();
+
+        for (std::size_t p = 0; p < num_buffered; ++p)
+        {
+            samples(dest_row[p], dest_col[p]) = samples_cos(p);
+
+            if (dest_row[p] + 1 < rows)
+                samples(dest_row[p] + 1, dest_col[p]) = samples_sin(p);
+        }
+
+        num_buffered = 0;
+    };
+
+    /* Each Philox block gives two pairs of uniforms, i.e. four rows of a column. */
+    for (std::size_t j = 0; j < static_cast<std::size_t>(samples.cols()); ++j)
+    {
+        for (std::size_t b = 0; b < num_blocks; ++b)
+        {
+            std::uint32_t bits[4];
+            philox_.generate((stream << 32) | b, first_column + j, bits);
+
+            for (std::size_t h = 0; h < 2 && 4 * b + 2 * h < rows; ++h)
+            {
+                u_1(num_buffered) = static_cast<float>((bits[2 * h]     >> 8) + 1) * (1.0f / 16777216.0f);
+                u_2(num_buffered) = static_cast<float>( bits[2 * h + 1] >> 8)      * (1.0f / 16777216.0f);
+
+                dest_row[num_buffered] = 4 * b + 2 * h;
+                dest_col[num_buffered] = j;
+
+                if (++num_buffered == num_pairs)
+                    transform();
+            }
+        }
+    }
+
+    if (num_buffered > 0)
+        transform();
+}
+
+
+MatrixXf GaussianSampler::sample(const std::size_t rows, const std::size_t cols)
+{
+    MatrixXf samples(rows, cols);
+    fill(samples);
+
+    return samples;
+}
+
+
+void GaussianSampler::fillBlock(float* samples)
+{
+    typedef Array<float, num_lanes, 1> ArrayLf;
+
+    /* One xoshiro256+ step per lane. */
+    std::uint64_t bits[num_lanes];
+    for (std::size_t l = 0; l < num_lanes; ++l)
+    {
+        bits[l] = state_[0][l] + state_[3][l];
+
+        const std::uint64_t t = state_[1][l] << 17;
+
+        state_[2][l] ^= state_[0][l];
+        state_[3][l] ^= state_[1][l];
+        state_[1][l] ^= state_[2][l];
+        state_[0][l] ^= state_[3][l];
+
+        state_[2][l] ^= t;
+        state_[3][l] = (state_[3][l] << 45) | (state_[3][l] >> 19);
+    }
+
+    /* The upper 24 bits give u_1 in (0, 1], the next 24 bits u_2 in [0, 1). */
+    ArrayLf u_1;
+    ArrayLf u_2;
+    for (std::size_t l = 0; l < num_lanes; ++l)
+    {
+        u_1(l) = static_cast<float>((bits[l] >> 40) + 1) * (1.0f / 16777216.0f);
+        u_2(l) = static_cast<float>((bits[l] >> 16) & 0xFFFFFF) * (1.0f / 16777216.0f);
+    }
+
+    /* Box-Muller transform. */
+    const ArrayLf radius = (-2.0f * u_1.log()).sqrt();
+    const ArrayLf theta  = static_cast<float>(2.0 * M_PI) * u_2;
+
+    Map<ArrayLf> samples_cos(samples);
+    Map<ArrayLf> samples_sin(samples + num_lanes);
+
+    samples_cos = radius * theta.cos();
+    samples_sin = radius * theta.sin();
+}
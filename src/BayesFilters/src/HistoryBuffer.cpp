@@ -1,14 +1,24 @@
 #include "BayesFilters/HistoryBuffer.h"
 
+#include <cmath>
+#include <utility>
+
 using namespace bfl;
 using namespace Eigen;
 
 
 HistoryBuffer::HistoryBuffer(HistoryBuffer&& history_buffer) noexcept :
     window_(history_buffer.window_),
-    history_buffer_(std::move(history_buffer.history_buffer_))
+    buffer_(std::move(history_buffer.buffer_)),
+    newest_(history_buffer.newest_),
+    num_elements_(history_buffer.num_elements_),
+    sum_(std::move(history_buffer.sum_)),
+    linear_sum_(std::move(history_buffer.linear_sum_)),
+    exponential_sum_(std::move(history_buffer.exponential_sum_))
 {
-    history_buffer.window_ = 0;
+    history_buffer.window_       = 0;
+    history_buffer.newest_       = 0;
+    history_buffer.num_elements_ = 0;
 }
 
 
@@ -19,7 +29,15 @@ HistoryBuffer& HistoryBuffer::operator=(HistoryBuffer&& history_buffer) noexcept
         window_ = history_buffer.window_;
         history_buffer.window_ = 0;
 
-        history_buffer_ = std::move(history_buffer.history_buffer_);
+        buffer_       = std::move(history_buffer.buffer_);
+        newest_       = history_buffer.newest_;
+        num_elements_ = history_buffer.num_elements_;
+        history_buffer.newest_       = 0;
+        history_buffer.num_elements_ = 0;
+
+        sum_             = std::move(history_buffer.sum_);
+        linear_sum_      = std::move(history_buffer.linear_sum_);
+        exponential_sum_ = std::move(history_buffer.exponential_sum_);
     }
 
     return *this;
@@ -28,25 +46,93 @@ HistoryBuffer& HistoryBuffer::operator=(HistoryBuffer&& history_buffer) noexcept
 
 void HistoryBuffer::addElement(const Ref<const VectorXf>& element)
 {
-    history_buffer_.push_front(element);
+    if (buffer_.rows() != element.size())
+    {
+        buffer_.resize(element.size(), max_window_);
+        num_elements_ = 0;
+    }
+
+    const VectorXd new_element = element.cast<double>();
+
+    if (num_elements_ == window_)
+    {
+        /* The oldest element leaves the window, which keeps its size n. */
+        const double   n       = num_elements_;
+        const VectorXd dropped = getElement(num_elements_ - 1).cast<double>();
+        const double   ratio   = std::exp(-1.0 / n);
+
+        /* Weights n, ..., 1 become n - 1, ..., 0, then the new element takes weight n. */
+        linear_sum_ -= sum_;
+        linear_sum_ += n * new_element;
+
+        sum_ += new_element - dropped;
+
+        /* Weights ratio^i become ratio^(i + 1), the dropped one reaching ratio^n. */
+        exponential_sum_ -= std::pow(ratio, n - 1.0) * dropped;
+        exponential_sum_ *= ratio;
+        exponential_sum_ += new_element;
+
+        newest_ = (newest_ + 1) % max_window_;
+        buffer_.col(newest_) = element;
+    }
+    else
+    {
+        newest_ = (newest_ + 1) % max_window_;
+        buffer_.col(newest_) = element;
+        ++num_elements_;
+
+        /* The exponential weights depend on n, hence they change while the window fills up. */
+        recomputeSums();
 
-    if (history_buffer_.size() > window_)
-        history_buffer_.pop_back();
+        return;
+    }
+
+    /* Periodically discard the accumulated rounding errors. */
+    if (newest_ == 0)
+        recomputeSums();
 }
 
 
 MatrixXf HistoryBuffer::getHistoryBuffer() const
 {
-    MatrixXf hist_out(7, history_buffer_.size());
+    MatrixXf hist_out(buffer_.rows(), num_elements_);
 
-    unsigned int i = 0;
-    for (const Ref<const VectorXf>& element : history_buffer_)
-        hist_out.col(i++) = element;
+    for (unsigned int i = 0; i < num_elements_; ++i)
+        hist_out.col(i) = getElement(i);
 
     return hist_out;
 }
 
 
+MatrixXf::ConstColXpr HistoryBuffer::getElement(const unsigned int i) const
+{
+    return buffer_.col(index(i));
+}
+
+
+VectorXf HistoryBuffer::getSimpleAverage() const
+{
+    return (sum_ / num_elements_).cast<float>();
+}
+
+
+VectorXf HistoryBuffer::getLinearAverage() const
+{
+    const double n = num_elements_;
+
+    return (linear_sum_ / (n * (n + 1.0) / 2.0)).cast<float>();
+}
+
+
+VectorXf HistoryBuffer::getExponentialAverage() const
+{
+    const double n     = num_elements_;
+    const double ratio = std::exp(-1.0 / n);
+
+    return (exponential_sum_ * (1.0 - ratio) / (1.0 - std::pow(ratio, n))).cast<float>();
+}
+
+
 bool HistoryBuffer::setHistorySize(const unsigned int window)
 {
     unsigned int tmp;
@@ -55,13 +141,14 @@ bool HistoryBuffer::setHistorySize(const unsigned int window)
     else if (window >= max_window_) tmp = max_window_;
     else                            tmp = window;
 
-    if (tmp < window_ && tmp < history_buffer_.size())
+    window_ = tmp;
+
+    if (num_elements_ > window_)
     {
-        for (unsigned int i = 0; i < (window_ - tmp); ++i)
-            history_buffer_.pop_back();
-    }
+        num_elements_ = window_;
 
-    window_ = tmp;
+        recomputeSums();
+    }
 
     return true;
 }
@@ -81,6 +168,38 @@ bool HistoryBuffer::increaseHistorySize()
 
 bool HistoryBuffer::clear()
 {
-    history_buffer_.clear();
+    num_elements_ = 0;
+
+    recomputeSums();
+
     return true;
 }
+
+
+unsigned int HistoryBuffer::index(const unsigned int i) const
+{
+    return (newest_ + max_window_ - i) % max_window_;
+}
+
+
+void HistoryBuffer::recomputeSums()
+{
+    const double n     = num_elements_;
+    const double ratio = std::exp(-1.0 / n);
+
+    sum_.setZero(buffer_.rows());
+    linear_sum_.setZero(buffer_.rows());
+    exponential_sum_.setZero(buffer_.rows());
+
+    double weight = 1.0;
+    for (unsigned int i = 0; i < num_elements_; ++i)
+    {
+        const VectorXd element = getElement(i).cast<double>();
+
+        sum_             += element;
+        linear_sum_      += (n - i) * element;
+        exponential_sum_ += weight * element;
+
+        weight *= ratio;
+    }
+}
@@ -0,0 +1,105 @@
+#include "BayesFilters/KLDSampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+KLDSampling::KLDSampling(const Ref<const VectorXf>& bin_size, const double epsilon, const double delta,
+                         const std::size_t min_particles, const std::size_t max_particles) noexcept :
+    bin_size_(bin_size),
+    epsilon_(epsilon > 0.0 ? epsilon : std::numeric_limits<double>::min()),
+    z_(normalUpperQuantile(delta > 0.0 ? std::min(delta, 0.5) : std::numeric_limits<double>::min())),
+    min_particles_(min_particles),
+    max_particles_(max_particles)
+{
+    bins_.reserve(max_particles_);
+}
+
+
+KLDSampling::KLDSampling(KLDSampling&& kld_sampling) noexcept :
+    bin_size_(std::move(kld_sampling.bin_size_)),
+    epsilon_(kld_sampling.epsilon_),
+    z_(kld_sampling.z_),
+    min_particles_(kld_sampling.min_particles_),
+    max_particles_(kld_sampling.max_particles_),
+    bins_(std::move(kld_sampling.bins_)) { }
+
+
+KLDSampling::~KLDSampling() noexcept { }
+
+
+KLDSampling& KLDSampling::operator=(KLDSampling&& kld_sampling) noexcept
+{
+    bin_size_      = std::move(kld_sampling.bin_size_);
+    epsilon_       = kld_sampling.epsilon_;
+    z_             = kld_sampling.z_;
+    min_particles_ = kld_sampling.min_particles_;
+    max_particles_ = kld_sampling.max_particles_;
+    bins_          = std::move(kld_sampling.bins_);
+
+    return *this;
+}
+
+
+std::size_t KLDSampling::numParticles(const Ref<const MatrixXf>& particles)
+{
+    return numParticles(countBins(particles));
+}
+
+
+std::size_t KLDSampling::numParticles(const std::size_t num_bins) const
+{
+    if (num_bins < 2)
+        return min_particles_;
+
+    /* Wilson-Hilferty approximation of the chi-square quantile with k - 1 degrees of freedom. */
+    const double a = 2.0 / (9.0 * (num_bins - 1));
+    const double b = 1.0 - a + std::sqrt(a) * z_;
+
+    const double num_particles = std::ceil((num_bins - 1) / (2.0 * epsilon_) * b * b * b);
+
+    /* Compare before the conversion, which is undefined beyond the range of std::size_t. */
+    if (!(num_particles < static_cast<double>(max_particles_)))
+        return max_particles_;
+
+    return std::max(static_cast<std::size_t>(num_particles), min_particles_);
+}
+
+
+std::size_t KLDSampling::countBins(const Ref<const MatrixXf>& particles)
+{
+    bins_.clear();
+
+    for (int j = 0; j < particles.cols(); ++j)
+    {
+        /* FNV-1a hash of the integer bin coordinates. */
+        std::uint64_t key = 14695981039346656037ULL;
+        for (int i = 0; i < bin_size_.size(); ++i)
+        {
+            if (bin_size_(i) <= 0.0f)
+                continue;
+
+            const std::int64_t bin = static_cast<std::int64_t>(std::floor(particles(i, j) / bin_size_(i)));
+
+            key = (key ^ static_cast<std::uint64_t>(bin)) * 1099511628211ULL;
+        }
+
+        bins_.insert(key);
+    }
+
+    return bins_.size();
+}
+
+
+double KLDSampling::normalUpperQuantile(const double p)
+{
+    /* Rational approximation [Abramowitz and Stegun, 26.2.23], valid for p in (0, 0.5]. */
+    const double t = std::sqrt(-2.0 * std::log(p));
+
+    return t - (2.515517 + 0.802853 * t + 0.010328 * t * t) / (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+}
@@ -1,18 +1,286 @@
 #include "BayesFilters/KalmanFilter.h"
 
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
 using namespace bfl;
+using namespace Eigen;
+
+
+KalmanFilter::KalmanFilter() noexcept { }
+
 
-    
-KalmanFilter::KalmanFilter() { }
+KalmanFilter::KalmanFilter(KalmanFilter&& kf) noexcept :
+    simulation_time_(kf.simulation_time_),
+    measurement_driven_(kf.measurement_driven_),
+    state_model_(std::move(kf.state_model_)),
+    observation_model_(std::move(kf.observation_model_)),
+    F_(std::move(kf.F_)),
+    H_(std::move(kf.H_)),
+    Q_(std::move(kf.Q_)),
+    R_(std::move(kf.R_)),
+    object_(std::move(kf.object_)),
+    measurement_(std::move(kf.measurement_)),
+    x_(std::move(kf.x_)),
+    P_(std::move(kf.P_)),
+    result_x_(std::move(kf.result_x_)),
+    result_P_(std::move(kf.result_P_)),
+    skip_prediction_(kf.skip_prediction_),
+    skip_correction_(kf.skip_correction_),
+    x_pred_(std::move(kf.x_pred_)),
+    P_pred_(std::move(kf.P_pred_)),
+    FP_(std::move(kf.FP_)),
+    y_(std::move(kf.y_)),
+    PHt_(std::move(kf.PHt_)),
+    S_(std::move(kf.S_)),
+    S_llt_(std::move(kf.S_llt_)),
+    Kt_(std::move(kf.Kt_)),
+    K_(std::move(kf.K_)),
+    IKH_(std::move(kf.IKH_)),
+    IKHP_(std::move(kf.IKHP_)),
+    KR_(std::move(kf.KR_)) { }
 
 
 KalmanFilter::~KalmanFilter() noexcept { }
 
 
-void KalmanFilter::initialization() { }
+KalmanFilter& KalmanFilter::operator=(KalmanFilter&& kf) noexcept
+{
+    simulation_time_    = kf.simulation_time_;
+    measurement_driven_ = kf.measurement_driven_;
+
+    state_model_       = std::move(kf.state_model_);
+    observation_model_ = std::move(kf.observation_model_);
+
+    F_ = std::move(kf.F_);
+    H_ = std::move(kf.H_);
+    Q_ = std::move(kf.Q_);
+    R_ = std::move(kf.R_);
+
+    object_      = std::move(kf.object_);
+    measurement_ = std::move(kf.measurement_);
+    x_           = std::move(kf.x_);
+    P_           = std::move(kf.P_);
+    result_x_    = std::move(kf.result_x_);
+    result_P_    = std::move(kf.result_P_);
+
+    skip_prediction_ = kf.skip_prediction_;
+    skip_correction_ = kf.skip_correction_;
+
+    x_pred_ = std::move(kf.x_pred_);
+    P_pred_ = std::move(kf.P_pred_);
+    FP_     = std::move(kf.FP_);
+    y_      = std::move(kf.y_);
+    PHt_    = std::move(kf.PHt_);
+    S_      = std::move(kf.S_);
+    S_llt_  = std::move(kf.S_llt_);
+    Kt_     = std::move(kf.Kt_);
+    K_      = std::move(kf.K_);
+    IKH_    = std::move(kf.IKH_);
+    IKHP_   = std::move(kf.IKHP_);
+    KR_     = std::move(kf.KR_);
+
+    return *this;
+}
+
+
+void KalmanFilter::setStateModel(std::unique_ptr<StateModel> state_model, const Ref<const MatrixXf>& F)
+{
+    state_model_ = std::move(state_model);
+    F_           = F;
+}
+
+
+void KalmanFilter::setObservationModel(std::unique_ptr<ObservationModel> observation_model, const Ref<const MatrixXf>& H)
+{
+    observation_model_ = std::move(observation_model);
+    H_                 = H;
+}
+
+
+bool KalmanFilter::skip(const std::string& what_step, const bool status)
+{
+    if (what_step == "prediction")
+        skip_prediction_ = status;
+    else if (what_step == "correction")
+        skip_correction_ = status;
+    else if (what_step == "all")
+    {
+        skip_prediction_ = status;
+        skip_correction_ = status;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+
+void KalmanFilter::initialization()
+{
+    const int state_size       = F_.rows();
+    const int measurement_size = H_.rows();
+
+    /* GENERATE MEASUREMENTS */
+    if (measurement_driven_)
+    {
+        /* step(measurement) writes each measurement in the only column. */
+        object_.resize(state_size, 0);
+        measurement_.setZero(measurement_size, 1);
+    }
+    else
+    {
+        object_.resize(state_size, simulation_time_);
+        measurement_.resize(measurement_size, simulation_time_);
+
+        object_.col(0).setZero();
+        observation_model_->measure(object_.col(0), measurement_.col(0));
+        for (unsigned int k = 1; k < simulation_time_; ++k)
+        {
+            state_model_->motion(object_.col(k - 1), object_.col(k));
+            observation_model_->measure(object_.col(k), measurement_.col(k));
+        }
+    }
+
+    /* INITIALIZE FILTER */
+    Q_ = state_model_->getNoiseCovarianceMatrix();
+    R_ = observation_model_->getNoiseCovarianceMatrix();
+
+    x_ = H_.transpose() * measurement_.col(0);
+
+    P_.resize(state_size, state_size);
+    P_.setIdentity();
+    P_ *= 1000.0;
+
+    const unsigned int num_results = measurement_driven_ ? 0 : simulation_time_;
+    result_x_.resize(state_size, num_results);
+    result_P_.resize(state_size * state_size, num_results);
+
+    /* ALLOCATE WORKSPACES */
+    x_pred_.resize(state_size);
+    P_pred_.resize(state_size, state_size);
+    FP_.resize(state_size, state_size);
+    y_.resize(measurement_size);
+    PHt_.resize(state_size, measurement_size);
+    S_.resize(measurement_size, measurement_size);
+    S_llt_ = LLT<MatrixXf>(measurement_size);
+    Kt_.resize(measurement_size, state_size);
+    K_.resize(state_size, measurement_size);
+    IKH_.resize(state_size, state_size);
+    IKHP_.resize(state_size, state_size);
+    KR_.resize(state_size, measurement_size);
+}
+
+
+void KalmanFilter::filteringStep()
+{
+    const unsigned int k = getFilteringStep();
+
+    if (k != 0 && !skip_prediction_)
+        predict();
+
+    if (!skip_correction_)
+        correct(measurement_.col(measurement_driven_ ? 0 : k));
+
+    if (!measurement_driven_)
+    {
+        result_x_.col(k) = x_;
+        result_P_.col(k) = Map<const VectorXf>(P_.data(), P_.size());
+    }
+}
+
+
+const VectorXf& KalmanFilter::step(const Ref<const VectorXf>& measurement)
+{
+    if (!measurement_driven_)
+    {
+        measurement_driven_ = true;
+        reset();
+    }
+
+    if (!prepareStep())
+        throw std::runtime_error("ERROR::KALMANFILTER::STEP\nERROR:\n\tThe filter cannot run further steps.");
+
+    if (measurement.size() != measurement_.rows())
+        throw std::runtime_error("ERROR::KALMANFILTER::STEP\nERROR:\n\tMeasurement size does not match the observation model.");
+
+    const unsigned int k = getFilteringStep();
+
+    measurement_.col(0) = measurement;
+
+    /* As in initialization(), the first measurement initializes the state. */
+    if (k == 0)
+        x_.noalias() = H_.transpose() * measurement;
+
+    FilteringAlgorithm::step();
+
+    return x_;
+}
+
+
+void KalmanFilter::getResult()
+{
+    std::ofstream result_file_object;
+    std::ofstream result_file_measurement;
+    std::ofstream result_file_state;
+    std::ofstream result_file_covariance;
+
+    result_file_object.open     ("./result_kf_object.txt");
+    result_file_measurement.open("./result_kf_measurement.txt");
+    result_file_state.open      ("./result_kf_state.txt");
+    result_file_covariance.open ("./result_kf_covariance.txt");
+
+    result_file_object      << object_;
+    result_file_measurement << measurement_;
+    result_file_state       << result_x_.leftCols(measurement_driven_ ? 0 : getFilteringStep());
+    result_file_covariance  << result_P_.leftCols(measurement_driven_ ? 0 : getFilteringStep());
+
+    result_file_object.close();
+    result_file_measurement.close();
+    result_file_state.close();
+    result_file_covariance.close();
+}
+
+
+void KalmanFilter::predict()
+{
+    /* x = F x */
+    x_pred_.noalias() = F_ * x_;
+    x_.swap(x_pred_);
+
+    /* P = F P F' + Q */
+    FP_.noalias() = F_ * P_;
+    P_.noalias()  = FP_ * F_.transpose();
+    P_ += Q_;
+}
+
+
+void KalmanFilter::correct(const Ref<const VectorXf>& measurement)
+{
+    /* Innovation y = z - H x and its covariance S = H P H' + R */
+    y_ = measurement;
+    y_.noalias() -= H_ * x_;
+
+    PHt_.noalias() = P_ * H_.transpose();
+    S_.noalias()   = H_ * PHt_;
+    S_ += R_;
+
+    /* Gain K = P H' S^-1, computed as the solution of S K' = H P */
+    S_llt_.compute(S_);
+    Kt_ = PHt_.transpose();
+    S_llt_.solveInPlace(Kt_);
+    K_ = Kt_.transpose();
 
+    x_.noalias() += K_ * y_;
 
-void KalmanFilter::filteringStep() { }
+    /* Joseph form P = (I - K H) P (I - K H)' + K R K' */
+    IKH_.noalias() = -K_ * H_;
+    IKH_.diagonal().array() += 1.0f;
 
+    IKHP_.noalias() = IKH_ * P_;
+    P_.noalias()    = IKHP_ * IKH_.transpose();
 
-void KalmanFilter::getResult() { }
+    KR_.noalias()   = K_ * R_;
+    P_.noalias()   += KR_ * K_.transpose();
+}
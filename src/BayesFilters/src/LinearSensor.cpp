@@ -10,9 +10,7 @@ using namespace Eigen;
 LinearSensor::LinearSensor(float sigma_x, float sigma_y, unsigned int seed) noexcept :
     sigma_x_(sigma_x),
     sigma_y_(sigma_y),
-    generator_(std::mt19937_64(seed)),
-    distribution_(std::normal_distribution<float>(0.0, 1.0)),
-    gauss_rnd_sample_([&] { return (distribution_)(generator_); })
+    gaussian_sampler_(seed)
 {
     H_.resize(2, 4);
     H_ << 1.0, 0.0, 0.0, 0.0,
@@ -43,9 +41,7 @@ LinearSensor::LinearSensor(const LinearSensor& lin_sense) :
     H_(lin_sense.H_),
     R_(lin_sense.R_),
     sqrt_R_(lin_sense.sqrt_R_),
-    generator_(lin_sense.generator_),
-    distribution_(lin_sense.distribution_),
-    gauss_rnd_sample_(lin_sense.gauss_rnd_sample_) { };
+    gaussian_sampler_(lin_sense.gaussian_sampler_) { };
 
 
 LinearSensor::LinearSensor(LinearSensor&& lin_sense) noexcept :
@@ -54,9 +50,7 @@ LinearSensor::LinearSensor(LinearSensor&& lin_sense) noexcept :
     H_(std::move(lin_sense.H_)),
     R_(std::move(lin_sense.R_)),
     sqrt_R_(std::move(lin_sense.sqrt_R_)),
-    generator_(std::move(lin_sense.generator_)),
-    distribution_(std::move(lin_sense.distribution_)),
-    gauss_rnd_sample_(std::move(lin_sense.gauss_rnd_sample_))
+    gaussian_sampler_(std::move(lin_sense.gaussian_sampler_))
 {
     lin_sense.sigma_x_ = 0.0;
     lin_sense.sigma_y_ = 0.0;
@@ -80,9 +74,7 @@ LinearSensor& LinearSensor::operator=(LinearSensor&& lin_sense) noexcept
     R_       = std::move(lin_sense.R_);
     sqrt_R_  = std::move(lin_sense.sqrt_R_);
 
-    generator_        = std::move(lin_sense.generator_);
-    distribution_     = std::move(lin_sense.distribution_);
-    gauss_rnd_sample_ = std::move(lin_sense.gauss_rnd_sample_);
+    gaussian_sampler_ = std::move(lin_sense.gaussian_sampler_);
 
     lin_sense.sigma_x_ = 0.0;
     lin_sense.sigma_y_ = 0.0;
@@ -108,8 +100,11 @@ void LinearSensor::measure(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf>
 MatrixXf LinearSensor::getNoiseSample(const int num)
 {
     MatrixXf rand_vectors(2, num);
-    for (int i = 0; i < rand_vectors.size(); i++)
-        *(rand_vectors.data() + i) = gauss_rnd_sample_();
+    {
+        std::lock_guard<std::mutex> lk(mtx_noise_);
+
+        gaussian_sampler_.fill(rand_vectors);
+    }
 
     return sqrt_R_ * rand_vectors;
 }
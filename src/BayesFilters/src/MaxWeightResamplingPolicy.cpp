@@ -0,0 +1,20 @@
+#include "BayesFilters/MaxWeightResamplingPolicy.h"
+
+using namespace bfl;
+
+
+MaxWeightResamplingPolicy::MaxWeightResamplingPolicy(double threshold) noexcept :
+    threshold_(threshold) { }
+
+
+MaxWeightResamplingPolicy::MaxWeightResamplingPolicy() noexcept :
+    MaxWeightResamplingPolicy(0.1) { }
+
+
+MaxWeightResamplingPolicy::~MaxWeightResamplingPolicy() noexcept { }
+
+
+bool MaxWeightResamplingPolicy::resample(const WeightStatistics& statistics, const unsigned int /* step */)
+{
+    return statistics.max_weight > threshold_;
+}
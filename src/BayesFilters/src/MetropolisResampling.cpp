@@ -0,0 +1,85 @@
+#include "BayesFilters/MetropolisResampling.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+MetropolisResampling::MetropolisResampling(unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+MetropolisResampling::MetropolisResampling() noexcept :
+    MetropolisResampling(1) { }
+
+
+MetropolisResampling::MetropolisResampling(MetropolisResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)),
+    num_iterations_(resampling.num_iterations_) { }
+
+
+MetropolisResampling::~MetropolisResampling() noexcept { }
+
+
+MetropolisResampling& MetropolisResampling::operator=(MetropolisResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+
+        num_iterations_ = resampling.num_iterations_;
+    }
+
+    return *this;
+}
+
+
+void MetropolisResampling::setNumIterations(const unsigned int num_iterations)
+{
+    num_iterations_ = num_iterations;
+}
+
+
+unsigned int MetropolisResampling::getNumIterations()
+{
+    return num_iterations_;
+}
+
+
+void MetropolisResampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::int64_t num_particles     = cor_weights.size();
+    const std::size_t  num_res_particles = res_ancestors.size();
+    const std::size_t  block_size        = ThreadPool::getBlockSize(1);
+    const bool         log_weights       = getLogWeights();
+
+    const std::vector<std::uint64_t> seeds = drawBlockSeeds((num_res_particles + block_size - 1) / block_size);
+
+    ThreadPool::forEachBlock(thread_pool_, num_res_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::mt19937_64 generator(seeds[begin / block_size]);
+                                 std::uniform_int_distribution<std::int64_t> distribution_idx(0, num_particles - 1);
+                                 std::uniform_real_distribution<float> distribution_acc(0.0, 1.0);
+
+                                 for (std::size_t j = begin; j < end; ++j)
+                                 {
+                                     std::int64_t k = j % num_particles;
+
+                                     for (unsigned int b = 0; b < num_iterations_; ++b)
+                                     {
+                                         const std::int64_t l = distribution_idx(generator);
+                                         const float        u = distribution_acc(generator);
+
+                                         if (log_weights ? (std::log(u) <= cor_weights(l) - cor_weights(k)) : (u * cor_weights(k) <= cor_weights(l)))
+                                             k = l;
+                                     }
+
+                                     res_ancestors(j) = k;
+                                 }
+                             });
+}
@@ -0,0 +1,349 @@
+#include "BayesFilters/MultimodalExtraction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+MultimodalExtraction::MultimodalExtraction(const Ref<const VectorXf>& bandwidth, const unsigned int max_modes) noexcept :
+    bandwidth_(bandwidth),
+    max_modes_(max_modes)
+{
+    for (int i = 0; i < bandwidth_.size(); ++i)
+    {
+        if (bandwidth_(i) > 0.0f)
+            clustered_.push_back(i);
+    }
+
+    /* Enumerate the 3^d offsets in {-1, 0, 1}^d by counting in base 3. */
+    const int dim = static_cast<int>(clustered_.size());
+
+    std::size_t num_offsets = 1;
+    for (int k = 0; k < dim; ++k)
+        num_offsets *= 3;
+
+    offsets_.reserve(num_offsets);
+    for (std::size_t o = 0; o < num_offsets; ++o)
+    {
+        VectorXi offset(dim);
+
+        std::size_t digits = o;
+        for (int k = 0; k < dim; ++k)
+        {
+            offset(k) = static_cast<int>(digits % 3) - 1;
+            digits /= 3;
+        }
+
+        offsets_.push_back(offset);
+    }
+}
+
+
+MultimodalExtraction::MultimodalExtraction(MultimodalExtraction&& multimodal_extraction) noexcept :
+    bandwidth_(std::move(multimodal_extraction.bandwidth_)),
+    max_modes_(multimodal_extraction.max_modes_),
+    max_iterations_(multimodal_extraction.max_iterations_),
+    thread_pool_(std::move(multimodal_extraction.thread_pool_)),
+    modes_(std::move(multimodal_extraction.modes_)),
+    masses_(std::move(multimodal_extraction.masses_)),
+    clustered_(std::move(multimodal_extraction.clustered_)),
+    offsets_(std::move(multimodal_extraction.offsets_)),
+    cells_(std::move(multimodal_extraction.cells_)),
+    centroids_(std::move(multimodal_extraction.centroids_)),
+    converged_(std::move(multimodal_extraction.converged_))
+{ }
+
+
+MultimodalExtraction::~MultimodalExtraction() noexcept
+{ }
+
+
+MultimodalExtraction& MultimodalExtraction::operator=(MultimodalExtraction&& multimodal_extraction) noexcept
+{
+    bandwidth_      = std::move(multimodal_extraction.bandwidth_);
+    max_modes_      = multimodal_extraction.max_modes_;
+    max_iterations_ = multimodal_extraction.max_iterations_;
+    thread_pool_    = std::move(multimodal_extraction.thread_pool_);
+    modes_          = std::move(multimodal_extraction.modes_);
+    masses_         = std::move(multimodal_extraction.masses_);
+    clustered_      = std::move(multimodal_extraction.clustered_);
+    offsets_        = std::move(multimodal_extraction.offsets_);
+    cells_          = std::move(multimodal_extraction.cells_);
+    centroids_      = std::move(multimodal_extraction.centroids_);
+    converged_      = std::move(multimodal_extraction.converged_);
+
+    return *this;
+}
+
+
+void MultimodalExtraction::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    thread_pool_ = std::move(thread_pool);
+}
+
+
+void MultimodalExtraction::setMaxIterations(const unsigned int max_iterations)
+{
+    max_iterations_ = max_iterations;
+}
+
+
+unsigned int MultimodalExtraction::extract(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights)
+{
+    if (particles.rows() != bandwidth_.size())
+        throw std::runtime_error("ERROR::MULTIMODALEXTRACTION::EXTRACT\nERROR:\n\tParticle size does not match the bandwidth size.");
+
+    if (particles.cols() != weights.size())
+        throw std::runtime_error("ERROR::MULTIMODALEXTRACTION::EXTRACT\nERROR:\n\tNumber of particles and weights do not match.");
+
+    const int size = static_cast<int>(particles.rows());
+    const int dim = static_cast<int>(clustered_.size());
+
+    binParticles(particles, weights);
+
+    const std::size_t num_cells = cells_.weights.size();
+    if (num_cells == 0)
+    {
+        modes_.resize(size, 0);
+        masses_.resize(0);
+
+        return 0;
+    }
+
+
+    /* Bandwidth-scaled centroids of the cells. */
+    centroids_.resize(dim, num_cells);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+        for (int k = 0; k < dim; ++k)
+            centroids_(k, c) = cells_.sums[c * size + clustered_[k]] / cells_.weights[c] / bandwidth_(clustered_[k]);
+    }
+
+
+    /* Mean-shift from each cell, independently. */
+    converged_.resize(dim, num_cells);
+
+    auto shift_kernel = [this](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t c = begin; c < end; ++c)
+            meanShift(c, converged_.col(c));
+    };
+
+    const std::size_t cells_per_block = 16;
+    ThreadPool::forEachBlock(thread_pool_, num_cells, cells_per_block, shift_kernel);
+
+
+    /* Cells whose fixed points are within half a bandwidth belong to the same
+     * mode. Visiting the cells by decreasing weight, the first cell of a mode
+     * is the heaviest one and its fixed point represents the mode.
+     * Representatives are hashed into the grid, so that only those in the 3^d
+     * cells around a fixed point are compared, and the earliest one within
+     * reach is taken. */
+    std::vector<std::size_t> order(num_cells);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](const std::size_t a, const std::size_t b) { return cells_.weights[a] > cells_.weights[b]; });
+
+    std::vector<std::size_t> representatives;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> representative_cells;
+    std::vector<double> mode_weights;
+    std::vector<VectorXd> mode_sums;
+
+    const VectorXi no_offset = VectorXi::Zero(dim);
+
+    for (const std::size_t c : order)
+    {
+        std::size_t m = representatives.size();
+        for (const VectorXi& offset : offsets_)
+        {
+            const auto found = representative_cells.find(cellKey(converged_.col(c), offset));
+            if (found == representative_cells.end())
+                continue;
+
+            for (const std::size_t r : found->second)
+            {
+                if (r < m && (converged_.col(c) - converged_.col(representatives[r])).squaredNorm() < 0.25)
+                    m = r;
+            }
+        }
+
+        if (m == representatives.size())
+        {
+            representative_cells[cellKey(converged_.col(c), no_offset)].push_back(m);
+            representatives.push_back(c);
+            mode_weights.push_back(0.0);
+            mode_sums.push_back(VectorXd::Zero(size));
+        }
+
+        mode_weights[m] += cells_.weights[c];
+        mode_sums[m] += Map<const VectorXd>(&cells_.sums[c * size], size);
+    }
+
+
+    /* Keep the heaviest modes. */
+    std::vector<std::size_t> modes(representatives.size());
+    std::iota(modes.begin(), modes.end(), 0);
+    std::stable_sort(modes.begin(), modes.end(),
+                     [&mode_weights](const std::size_t a, const std::size_t b) { return mode_weights[a] > mode_weights[b]; });
+
+    const double total_weight = std::accumulate(mode_weights.begin(), mode_weights.end(), 0.0);
+    const std::size_t num_modes = std::min<std::size_t>(max_modes_, modes.size());
+
+    modes_.resize(size, num_modes);
+    masses_.resize(num_modes);
+    for (std::size_t i = 0; i < num_modes; ++i)
+    {
+        modes_.col(i) = (mode_sums[modes[i]] / mode_weights[modes[i]]).cast<float>();
+        masses_(i) = static_cast<float>(mode_weights[modes[i]] / total_weight);
+    }
+
+    return static_cast<unsigned int>(num_modes);
+}
+
+
+const MatrixXf& MultimodalExtraction::getModes() const
+{
+    return modes_;
+}
+
+
+const VectorXf& MultimodalExtraction::getMasses() const
+{
+    return masses_;
+}
+
+
+void MultimodalExtraction::binParticles(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights)
+{
+    const std::size_t size = particles.rows();
+    const std::size_t num_particles = particles.cols();
+    const int dim = static_cast<int>(clustered_.size());
+
+    /* Blocks are fixed irrespective of the thread pool, so that the cells are
+     * accumulated in the same order with or without it. */
+    const std::size_t block_size = ThreadPool::getBlockSize(size);
+    const std::size_t num_blocks = (num_particles + block_size - 1) / block_size;
+
+    std::vector<Cells> block_cells(num_blocks);
+
+    auto bin_kernel = [&](const std::size_t begin, const std::size_t end)
+    {
+        Cells& cells = block_cells[begin / block_size];
+
+        const VectorXi no_offset = VectorXi::Zero(dim);
+        VectorXd scaled(dim);
+        VectorXd weighted_state(size);
+
+        for (std::size_t j = begin; j < end; ++j)
+        {
+            if (!(weights(j) > 0.0f))
+                continue;
+
+            for (int k = 0; k < dim; ++k)
+                scaled(k) = static_cast<double>(particles(clustered_[k], j)) / bandwidth_(clustered_[k]);
+
+            weighted_state = weights(j) * particles.col(j).cast<double>();
+
+            addToCell(cells, cellKey(scaled, no_offset), weights(j), weighted_state.data(), size);
+        }
+    };
+
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size, bin_kernel);
+
+
+    /* Merge the cells of each block, in order. */
+    cells_.index.clear();
+    cells_.keys.clear();
+    cells_.weights.clear();
+    cells_.sums.clear();
+
+    for (const Cells& cells : block_cells)
+    {
+        for (std::size_t c = 0; c < cells.keys.size(); ++c)
+            addToCell(cells_, cells.keys[c], cells.weights[c], &cells.sums[c * size], size);
+    }
+}
+
+
+void MultimodalExtraction::meanShift(const std::size_t cell, Ref<VectorXd> point) const
+{
+    const int dim = static_cast<int>(clustered_.size());
+
+    VectorXd current = centroids_.col(cell);
+    VectorXd shifted(dim);
+
+    for (unsigned int it = 0; it < max_iterations_; ++it)
+    {
+        /* The Epanechnikov kernel has unit radius in scaled coordinates, hence
+         * only the centroids in the cells around the current point count. */
+        shifted.setZero();
+        double normalization = 0.0;
+
+        for (const VectorXi& offset : offsets_)
+        {
+            const auto found = cells_.index.find(cellKey(current, offset));
+            if (found == cells_.index.end())
+                continue;
+
+            const std::size_t c = found->second;
+            const double distance = (centroids_.col(c) - current).squaredNorm();
+            if (distance >= 1.0)
+                continue;
+
+            const double kernel = cells_.weights[c] * (1.0 - distance);
+            shifted += kernel * centroids_.col(c);
+            normalization += kernel;
+        }
+
+        if (normalization <= 0.0)
+            break;
+
+        shifted /= normalization;
+
+        const double step = (shifted - current).squaredNorm();
+        current = shifted;
+
+        if (step < 1e-6)
+            break;
+    }
+
+    point = current;
+}
+
+
+std::uint64_t MultimodalExtraction::cellKey(const Ref<const VectorXd>& scaled_point, const Ref<const VectorXi>& offset)
+{
+    std::uint64_t key = 14695981039346656037ULL;
+    for (int k = 0; k < scaled_point.size(); ++k)
+    {
+        const std::int64_t bin = static_cast<std::int64_t>(std::floor(scaled_point(k))) + offset(k);
+
+        key = (key ^ static_cast<std::uint64_t>(bin)) * 1099511628211ULL;
+    }
+
+    return key;
+}
+
+
+void MultimodalExtraction::addToCell(Cells& cells, const std::uint64_t key, const double weight, const double* sum, const std::size_t size)
+{
+    const auto inserted = cells.index.emplace(key, cells.keys.size());
+
+    if (inserted.second)
+    {
+        cells.keys.push_back(key);
+        cells.weights.push_back(0.0);
+        cells.sums.resize(cells.sums.size() + size, 0.0);
+    }
+
+    const std::size_t c = inserted.first->second;
+
+    cells.weights[c] += weight;
+    for (std::size_t i = 0; i < size; ++i)
+        cells.sums[c * size + i] += sum[i];
+}
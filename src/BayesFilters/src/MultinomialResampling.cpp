@@ -0,0 +1,55 @@
+#include "BayesFilters/MultinomialResampling.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+MultinomialResampling::MultinomialResampling(unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+MultinomialResampling::MultinomialResampling() noexcept :
+    Resampling(1) { }
+
+
+MultinomialResampling::MultinomialResampling(MultinomialResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+MultinomialResampling::~MultinomialResampling() noexcept { }
+
+
+MultinomialResampling& MultinomialResampling::operator=(MultinomialResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+    }
+
+    return *this;
+}
+
+
+void MultinomialResampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::size_t num_res_particles = res_ancestors.size();
+    const std::size_t block_size        = ThreadPool::getBlockSize(1);
+
+    const double total = cumulativeWeights(cor_weights, getLogWeights());
+
+    const std::vector<std::uint64_t> seeds = drawBlockSeeds((num_res_particles + block_size - 1) / block_size);
+
+    ThreadPool::forEachBlock(thread_pool_, num_res_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::mt19937_64 generator(seeds[begin / block_size]);
+                                 std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+                                 for (std::size_t j = begin; j < end; ++j)
+                                     res_ancestors(j) = searchCumulativeWeights(distribution(generator) * total, -1);
+                             });
+}
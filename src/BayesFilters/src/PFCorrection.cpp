@@ -1,5 +1,8 @@
 #include "BayesFilters/PFCorrection.h"
 
+#include <cmath>
+#include <utility>
+
 using namespace bfl;
 using namespace Eigen;
 
@@ -8,9 +11,12 @@ PFCorrection::PFCorrection() noexcept { };
 
 
 PFCorrection::PFCorrection(PFCorrection&& pf_prediction) noexcept :
-    skip_(pf_prediction.skip_)
+    thread_pool_(std::move(pf_prediction.thread_pool_)),
+    skip_(pf_prediction.skip_),
+    log_weights_(pf_prediction.log_weights_)
 {
-    pf_prediction.skip_ = false;
+    pf_prediction.skip_        = false;
+    pf_prediction.log_weights_ = false;
 }
 
 
@@ -28,9 +34,41 @@ void PFCorrection::correct(const Ref<const MatrixXf>& pred_states, const Ref<con
 }
 
 
+void PFCorrection::likelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_weights)
+{
+    for (int i = 0; i < innovations.cols(); ++i)
+        cor_weights(i) = likelihood(innovations.col(i));
+}
+
+
+void PFCorrection::logLikelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_log_weights)
+{
+    for (int i = 0; i < innovations.cols(); ++i)
+        cor_log_weights(i) = std::log(likelihood(innovations.col(i)));
+}
+
+
 bool PFCorrection::skip(const bool status)
 {
     skip_ = status;
 
     return true;
 }
+
+
+void PFCorrection::setLogWeights(const bool status)
+{
+    log_weights_ = status;
+}
+
+
+bool PFCorrection::getLogWeights()
+{
+    return log_weights_;
+}
+
+
+void PFCorrection::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    thread_pool_ = std::move(thread_pool);
+}
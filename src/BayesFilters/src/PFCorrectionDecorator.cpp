@@ -29,6 +29,34 @@ double PFCorrectionDecorator::likelihood(const Ref<const VectorXf>& innovation)
 }
 
 
+void PFCorrectionDecorator::likelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_weights)
+{
+    correction_->likelihoods(innovations, cor_weights);
+}
+
+
+void PFCorrectionDecorator::logLikelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_log_weights)
+{
+    correction_->logLikelihoods(innovations, cor_log_weights);
+}
+
+
+void PFCorrectionDecorator::setLogWeights(const bool status)
+{
+    PFCorrection::setLogWeights(status);
+
+    correction_->setLogWeights(status);
+}
+
+
+void PFCorrectionDecorator::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    PFCorrection::setThreadPool(thread_pool);
+
+    correction_->setThreadPool(thread_pool);
+}
+
+
 ObservationModel& PFCorrectionDecorator::getObservationModel()
 {
     return correction_->getObservationModel();
@@ -2,6 +2,7 @@
 
 #include <exception>
 #include <iostream>
+#include <utility>
 
 using namespace bfl;
 using namespace Eigen;
@@ -11,13 +12,16 @@ PFPrediction::PFPrediction() noexcept { };
 
 
 PFPrediction::PFPrediction(PFPrediction&& pf_prediction) noexcept :
+    thread_pool_(std::move(pf_prediction.thread_pool_)),
     skip_prediction_(pf_prediction.skip_prediction_),
     skip_state_(pf_prediction.skip_state_),
-    skip_exogenous_(pf_prediction.skip_exogenous_)
+    skip_exogenous_(pf_prediction.skip_exogenous_),
+    log_weights_(pf_prediction.log_weights_)
 {
     pf_prediction.skip_prediction_ = false;
     pf_prediction.skip_state_      = false;
     pf_prediction.skip_exogenous_  = false;
+    pf_prediction.log_weights_     = false;
 }
 
 
@@ -73,3 +77,21 @@ void PFPrediction::setExogenousModel(std::unique_ptr<ExogenousModel> exogenous_m
     std::cerr << "ERROR::PFPREDICTION::SETEXOGENOUSMODEL\n";
     std::cerr << "ERROR:\n\tCall to unimplemented base class method." << std::endl;
 }
+
+
+void PFPrediction::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    thread_pool_ = std::move(thread_pool);
+}
+
+
+void PFPrediction::setLogWeights(const bool status)
+{
+    log_weights_ = status;
+}
+
+
+bool PFPrediction::getLogWeights()
+{
+    return log_weights_;
+}
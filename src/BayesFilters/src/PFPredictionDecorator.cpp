@@ -55,3 +55,31 @@ void PFPredictionDecorator::setExogenousModel(std::unique_ptr<ExogenousModel> ex
 {
     prediction_->setExogenousModel(std::move(exogenous_model));
 }
+
+
+void PFPredictionDecorator::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    PFPrediction::setThreadPool(thread_pool);
+
+    prediction_->setThreadPool(thread_pool);
+}
+
+
+void PFPredictionDecorator::setLogWeights(const bool status)
+{
+    PFPrediction::setLogWeights(status);
+
+    prediction_->setLogWeights(status);
+}
+
+
+void PFPredictionDecorator::setMeasurement(const Ref<const VectorXf>& measurement)
+{
+    prediction_->setMeasurement(measurement);
+}
+
+
+void PFPredictionDecorator::resetNoise()
+{
+    prediction_->resetNoise();
+}
@@ -1,9 +1,12 @@
 #include "BayesFilters/ParticleFilter.h"
+#include "BayesFilters/ESSResamplingPolicy.h"
 
 using namespace bfl;
+using namespace Eigen;
 
 
-ParticleFilter::ParticleFilter() noexcept { }
+ParticleFilter::ParticleFilter() noexcept :
+    resampling_policy_(new ESSResamplingPolicy()) { }
 
 
 ParticleFilter::~ParticleFilter() noexcept { }
@@ -13,7 +16,13 @@ ParticleFilter::ParticleFilter(ParticleFilter&& pf) noexcept :
     initialization_(std::move(pf.initialization_)),
     prediction_(std::move(pf.prediction_)),
     correction_(std::move(pf.correction_)),
-    resampling_(std::move(pf.resampling_)) { }
+    resampling_(std::move(pf.resampling_)),
+    resampling_policy_(std::move(pf.resampling_policy_)),
+    log_weights_(pf.log_weights_),
+    thread_pool_(std::move(pf.thread_pool_))
+{
+    pf.log_weights_ = false;
+}
 
 
 ParticleFilter& ParticleFilter::operator=(ParticleFilter&& pf) noexcept
@@ -23,6 +32,13 @@ ParticleFilter& ParticleFilter::operator=(ParticleFilter&& pf) noexcept
     correction_     = std::move(pf.correction_);
     resampling_     = std::move(pf.resampling_);
 
+    resampling_policy_ = std::move(pf.resampling_policy_);
+
+    log_weights_    = pf.log_weights_;
+    pf.log_weights_ = false;
+
+    thread_pool_    = std::move(pf.thread_pool_);
+
     return *this;
 }
 
@@ -36,18 +52,33 @@ void ParticleFilter::setInitialization(std::unique_ptr<Initialization> initializ
 void ParticleFilter::setPrediction(std::unique_ptr<PFPrediction> prediction)
 {
     prediction_ = std::move(prediction);
+
+    prediction_->setLogWeights(log_weights_);
+    prediction_->setThreadPool(thread_pool_);
 }
 
 
 void ParticleFilter::setCorrection(std::unique_ptr<PFCorrection> correction)
 {
     correction_ = std::move(correction);
+
+    correction_->setLogWeights(log_weights_);
+    correction_->setThreadPool(thread_pool_);
 }
 
 
 void ParticleFilter::setResampling(std::unique_ptr<Resampling> resampling)
 {
     resampling_ = std::move(resampling);
+
+    resampling_->setLogWeights(log_weights_);
+    resampling_->setThreadPool(thread_pool_);
+}
+
+
+void ParticleFilter::setResamplingPolicy(std::unique_ptr<ResamplingPolicy> resampling_policy)
+{
+    resampling_policy_ = std::move(resampling_policy);
 }
 
 
@@ -76,3 +107,54 @@ bool ParticleFilter::skip(const std::string& what_step, const bool status)
 
     return false;
 }
+
+
+void ParticleFilter::setLogWeights(const bool status)
+{
+    log_weights_ = status;
+
+    if (prediction_)
+        prediction_->setLogWeights(status);
+
+    if (correction_)
+        correction_->setLogWeights(status);
+
+    if (resampling_)
+        resampling_->setLogWeights(status);
+}
+
+
+bool ParticleFilter::getLogWeights()
+{
+    return log_weights_;
+}
+
+
+void ParticleFilter::setNumThreads(const unsigned int num_threads)
+{
+    if (num_threads == 1)
+        thread_pool_.reset();
+    else
+        thread_pool_ = std::make_shared<ThreadPool>(num_threads);
+
+    if (prediction_)
+        prediction_->setThreadPool(thread_pool_);
+
+    if (correction_)
+        correction_->setThreadPool(thread_pool_);
+
+    if (resampling_)
+        resampling_->setThreadPool(thread_pool_);
+}
+
+
+unsigned int ParticleFilter::getNumThreads()
+{
+    return thread_pool_ ? thread_pool_->getNumThreads() : 1;
+}
+
+
+WeightStatistics ParticleFilter::normalizeWeights(Ref<VectorXf> weights)
+{
+    return bfl::normalizeWeights(weights, log_weights_, thread_pool_, block_statistics_);
+}
@@ -0,0 +1,20 @@
+#include "BayesFilters/PeriodicResamplingPolicy.h"
+
+using namespace bfl;
+
+
+PeriodicResamplingPolicy::PeriodicResamplingPolicy(unsigned int period) noexcept :
+    period_(period) { }
+
+
+PeriodicResamplingPolicy::PeriodicResamplingPolicy() noexcept :
+    PeriodicResamplingPolicy(1) { }
+
+
+PeriodicResamplingPolicy::~PeriodicResamplingPolicy() noexcept { }
+
+
+bool PeriodicResamplingPolicy::resample(const WeightStatistics& /* statistics */, const unsigned int step)
+{
+    return period_ != 0 && step % period_ == 0;
+}
@@ -0,0 +1,44 @@
+#include "BayesFilters/Philox.h"
+
+using namespace bfl;
+
+
+Philox::Philox(const std::uint64_t seed) noexcept :
+    key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} { }
+
+
+Philox::Philox() noexcept :
+    Philox(1) { }
+
+
+Philox::~Philox() noexcept { }
+
+
+void Philox::generate(const std::uint64_t c_0, const std::uint64_t c_1, std::uint32_t output[4]) const
+{
+    std::uint32_t c[4] = { static_cast<std::uint32_t>(c_0), static_cast<std::uint32_t>(c_0 >> 32),
+                           static_cast<std::uint32_t>(c_1), static_cast<std::uint32_t>(c_1 >> 32) };
+    std::uint32_t k[2] = { key_[0], key_[1] };
+
+    for (unsigned int round = 0; round < 10; ++round)
+    {
+        const std::uint64_t prod_0 = static_cast<std::uint64_t>(0xD2511F53) * c[0];
+        const std::uint64_t prod_1 = static_cast<std::uint64_t>(0xCD9E8D57) * c[2];
+
+        const std::uint32_t c_1_prev = c[1];
+        const std::uint32_t c_3_prev = c[3];
+
+        c[0] = static_cast<std::uint32_t>(prod_1 >> 32) ^ c_1_prev ^ k[0];
+        c[1] = static_cast<std::uint32_t>(prod_1);
+        c[2] = static_cast<std::uint32_t>(prod_0 >> 32) ^ c_3_prev ^ k[1];
+        c[3] = static_cast<std::uint32_t>(prod_0);
+
+        k[0] += 0x9E3779B9;
+        k[1] += 0xBB67AE85;
+    }
+
+    output[0] = c[0];
+    output[1] = c[1];
+    output[2] = c[2];
+    output[3] = c[3];
+}
@@ -0,0 +1,453 @@
+#include "BayesFilters/RBPF.h"
+#include "BayesFilters/BatchKalmanFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+RBPF::RBPF() noexcept { }
+
+
+RBPF::RBPF(RBPF&& rbpf) noexcept :
+    ParticleFilter(std::move(rbpf)),
+    simulation_time_(rbpf.simulation_time_),
+    measurement_driven_(rbpf.measurement_driven_),
+    num_particle_(rbpf.num_particle_),
+    surv_x_(rbpf.surv_x_),
+    surv_y_(rbpf.surv_y_),
+    state_model_(std::move(rbpf.state_model_)),
+    observation_model_(std::move(rbpf.observation_model_)),
+    F_(std::move(rbpf.F_)),
+    H_(std::move(rbpf.H_)),
+    sampled_states_(std::move(rbpf.sampled_states_)),
+    linear_states_(std::move(rbpf.linear_states_)),
+    gaussian_sampler_(std::move(rbpf.gaussian_sampler_)),
+    noise_step_(rbpf.noise_step_),
+    skip_prediction_(rbpf.skip_prediction_),
+    skip_correction_(rbpf.skip_correction_) { }
+
+
+RBPF::~RBPF() noexcept { }
+
+
+RBPF& RBPF::operator=(RBPF&& rbpf) noexcept
+{
+    ParticleFilter::operator=(std::move(rbpf));
+
+    simulation_time_    = rbpf.simulation_time_;
+    measurement_driven_ = rbpf.measurement_driven_;
+    num_particle_       = rbpf.num_particle_;
+    surv_x_             = rbpf.surv_x_;
+    surv_y_             = rbpf.surv_y_;
+
+    state_model_       = std::move(rbpf.state_model_);
+    observation_model_ = std::move(rbpf.observation_model_);
+
+    F_ = std::move(rbpf.F_);
+    H_ = std::move(rbpf.H_);
+
+    sampled_states_ = std::move(rbpf.sampled_states_);
+    linear_states_  = std::move(rbpf.linear_states_);
+
+    gaussian_sampler_ = std::move(rbpf.gaussian_sampler_);
+    noise_step_       = rbpf.noise_step_;
+
+    skip_prediction_ = rbpf.skip_prediction_;
+    skip_correction_ = rbpf.skip_correction_;
+
+    return *this;
+}
+
+
+void RBPF::setStateModel(std::unique_ptr<StateModel> state_model, const Ref<const MatrixXf>& F)
+{
+    state_model_ = std::move(state_model);
+    F_           = F;
+}
+
+
+void RBPF::setObservationModel(std::unique_ptr<ObservationModel> observation_model, const Ref<const MatrixXf>& H)
+{
+    observation_model_ = std::move(observation_model);
+    H_                 = H;
+}
+
+
+void RBPF::setLinearStates(const std::vector<int>& linear_states)
+{
+    linear_states_ = linear_states;
+}
+
+
+bool RBPF::skip(const std::string& what_step, const bool status)
+{
+    if (what_step == "prediction")
+        skip_prediction_ = status;
+    else if (what_step == "correction")
+        skip_correction_ = status;
+    else if (what_step == "all")
+    {
+        skip_prediction_ = status;
+        skip_correction_ = status;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+
+void RBPF::initialization()
+{
+    if (linear_states_.empty() || linear_states_.size() >= static_cast<std::size_t>(F_.rows()))
+        throw std::runtime_error("ERROR::RBPF::INITIALIZATION\nERROR:\n\tBoth the sampled and the linear states must be non-empty.");
+
+    const int state_size       = F_.rows();
+    const int measurement_size = H_.rows();
+
+    /* GENERATE MEASUREMENTS */
+    if (measurement_driven_)
+    {
+        /* step(measurement) writes each measurement in the only column. */
+        object_.resize(state_size, 0);
+        measurement_.setZero(measurement_size, 1);
+    }
+    else
+    {
+        object_.resize(state_size, simulation_time_);
+        measurement_.resize(measurement_size, simulation_time_);
+
+        object_.col(0).setZero();
+        observation_model_->measure(object_.col(0), measurement_.col(0));
+        for (unsigned int k = 1; k < simulation_time_; ++k)
+        {
+            state_model_->motion(object_.col(k - 1), object_.col(k));
+            observation_model_->measure(object_.col(k), measurement_.col(k));
+        }
+    }
+
+    /* INITIALIZE FILTER */
+    partitionModel();
+
+    noise_step_ = 0;
+
+    const int sampled_size = sampled_states_.size();
+    const int linear_size  = linear_states_.size();
+
+    particles_.setZero(num_particle_, sampled_size);
+    int particle_spread = std::sqrt(num_particle_);
+    for (int i = 0; i < particle_spread; ++i)
+        for (int j = 0; j < particle_spread; ++j)
+        {
+            particles_(i * particle_spread + j, 0) = (surv_x_ / particle_spread) * i;
+            if (sampled_size > 1)
+                particles_(i * particle_spread + j, 1) = (surv_y_ / particle_spread) * j;
+        }
+
+    means_.setZero(num_particle_, linear_size);
+    covariances_.resize(num_particle_, linear_size * linear_size);
+    covariances_.rowwise() = vectorize(1000.0 * MatrixXf::Identity(linear_size, linear_size));
+
+    if (log_weights_)
+        weights_.setConstant(num_particle_, -std::log(static_cast<float>(num_particle_)));
+    else
+        weights_.setConstant(num_particle_, 1.0 / num_particle_);
+
+    result_state_.resize(state_size, measurement_driven_ ? 0 : simulation_time_);
+}
+
+
+void RBPF::filteringStep()
+{
+    const int k = getFilteringStep();
+
+    if (k != 0 && !skip_prediction_)
+        predict();
+
+    if (!skip_correction_)
+        correct(measurement_.col(measurement_driven_ ? 0 : k));
+
+    const WeightStatistics statistics = normalizeWeights(weights_);
+
+    estimate_ = estimate();
+    if (!measurement_driven_)
+        result_state_.col(k) = estimate_;
+
+    if (resampling_policy_->resample(statistics, k))
+        resample();
+}
+
+
+const VectorXf& RBPF::step(const Ref<const VectorXf>& measurement)
+{
+    if (!measurement_driven_)
+    {
+        measurement_driven_ = true;
+        reset();
+    }
+
+    if (!prepareStep())
+        throw std::runtime_error("ERROR::RBPF::STEP\nERROR:\n\tThe filter cannot run further steps.");
+
+    if (measurement.size() != measurement_.rows())
+        throw std::runtime_error("ERROR::RBPF::STEP\nERROR:\n\tMeasurement size does not match the observation model.");
+
+    measurement_.col(0) = measurement;
+
+    FilteringAlgorithm::step();
+
+    return estimate_;
+}
+
+
+void RBPF::getResult()
+{
+    std::ofstream result_file_object;
+    std::ofstream result_file_measurement;
+    std::ofstream result_file_state;
+
+    result_file_object.open     ("./result_rbpf_object.txt");
+    result_file_measurement.open("./result_rbpf_measurement.txt");
+    result_file_state.open      ("./result_rbpf_state.txt");
+
+    result_file_object      << object_;
+    result_file_measurement << measurement_;
+    result_file_state       << result_state_.leftCols(measurement_driven_ ? 0 : getFilteringStep());
+
+    result_file_object.close();
+    result_file_measurement.close();
+    result_file_state.close();
+}
+
+
+void RBPF::predict()
+{
+    const int sampled_size = sampled_states_.size();
+
+    /* Predictive density of the sampled states, N(F_ss x_s + F_sl m, F_sl P F_sl' + Q_ss) */
+    transitions_.noalias() = particles_ * F_ss_t_;
+
+    pred_particles_ = transitions_;
+    pred_particles_.noalias() += means_ * F_sl_t_;
+
+    S_.noalias() = covariances_ * FF_sl_t_;
+    S_.rowwise() += Q_ss_;
+    BatchKalmanFilter::choleskyColumns(S_, sampled_size);
+
+    PHt_.noalias() = covariances_ * FI_sl_t_;
+
+    /* The noise is keyed by step and particle index */
+    noise_.resize(sampled_size, particles_.rows());
+    gaussian_sampler_.fill(noise_, noise_step_, 0);
+    ++noise_step_;
+
+    /* The innovations of the sampled transition are L * noise */
+    innovations_.setZero(particles_.rows(), sampled_size);
+    for (int a = 0; a < sampled_size; ++a)
+        for (int k = 0; k <= a; ++k)
+            innovations_.col(a).array() += S_.col(a + sampled_size * k).array() * noise_.row(k).transpose().array();
+
+    pred_particles_ += innovations_;
+
+    /* z = x_s(k) - F_ss x_s(k-1) is a measurement of the linear part through F_sl, with noise covariance Q_ss */
+    transitions_ = pred_particles_ - transitions_;
+
+    updateLinear(sampled_size);
+
+    /* m = (F_ll - G F_sl) m + F_ls x_s(k-1) + G z, with G = Q_ls Q_ss^-1 decorrelating the process noise */
+    tmp_.noalias() = means_ * F_ll_t_;
+    tmp_.noalias() += particles_ * F_ls_t_;
+    tmp_.noalias() += transitions_ * G_t_;
+    means_.swap(tmp_);
+
+    tmp_.noalias() = covariances_ * FF_ll_t_;
+    tmp_.rowwise() += Q_ll_;
+    covariances_.swap(tmp_);
+
+    particles_.swap(pred_particles_);
+}
+
+
+void RBPF::correct(const Ref<const VectorXf>& measurement)
+{
+    const int measurement_size = H_.rows();
+
+    /* Innovations y = z - H_s x_s - H_l m, covariances S = H_l P H_l' + R and cross covariances P H_l' */
+    innovations_.resize(particles_.rows(), measurement_size);
+    innovations_.rowwise() = measurement.transpose();
+    innovations_.noalias() -= particles_ * H_s_t_;
+    innovations_.noalias() -= means_ * H_l_t_;
+
+    S_.noalias() = covariances_ * HH_l_t_;
+    S_.rowwise() += R_;
+    BatchKalmanFilter::choleskyColumns(S_, measurement_size);
+
+    PHt_.noalias() = covariances_ * HI_l_t_;
+
+    /* Marginal log-likelihoods -0.5 |L^-1 y|^2 - log|L| - 0.5 m log(2 pi) */
+    tmp_ = innovations_;
+    BatchKalmanFilter::lowerSolveColumns(S_, measurement_size, tmp_);
+
+    log_likelihoods_ = -0.5f * tmp_.rowwise().squaredNorm();
+    log_likelihoods_.array() -= 0.5f * measurement_size * std::log(2.0f * static_cast<float>(M_PI));
+    for (int a = 0; a < measurement_size; ++a)
+        log_likelihoods_.array() -= S_.col(a + measurement_size * a).array().log();
+
+    if (log_weights_)
+        weights_ += log_likelihoods_;
+    else
+    {
+        /* The likelihoods are rescaled by their maximum, which the weight normalization cancels out. */
+        const float max_log_likelihood = log_likelihoods_.maxCoeff();
+        weights_.array() *= (log_likelihoods_.array() - max_log_likelihood).exp();
+    }
+
+    updateLinear(measurement_size);
+}
+
+
+void RBPF::resample()
+{
+    const int num_particles = particles_.rows();
+
+    ancestors_.resize(num_particles);
+    resampling_->ancestors(weights_, ancestors_);
+
+    tmp_.resize(num_particles, particles_.cols());
+    gatherRows(particles_, ancestors_, tmp_);
+    particles_.swap(tmp_);
+
+    tmp_.resize(num_particles, means_.cols());
+    gatherRows(means_, ancestors_, tmp_);
+    means_.swap(tmp_);
+
+    tmp_.resize(num_particles, covariances_.cols());
+    gatherRows(covariances_, ancestors_, tmp_);
+    covariances_.swap(tmp_);
+
+    if (log_weights_)
+        weights_.setConstant(-std::log(static_cast<float>(num_particles)));
+    else
+        weights_.setConstant(1.0 / num_particles);
+}
+
+
+void RBPF::updateLinear(const int measurement_size)
+{
+    const int linear_size = linear_states_.size();
+
+    /* Gain K = P H' S^-1 */
+    K_ = PHt_;
+    BatchKalmanFilter::rightSolveColumns(S_, measurement_size, K_, linear_size);
+
+    /* m = m + K y */
+    for (int i = 0; i < linear_size; ++i)
+        for (int a = 0; a < measurement_size; ++a)
+            means_.col(i).array() += K_.col(i + linear_size * a).array() * innovations_.col(a).array();
+
+    /* P = P - K (P H')' */
+    for (int j = 0; j < linear_size; ++j)
+        for (int i = 0; i < linear_size; ++i)
+            for (int a = 0; a < measurement_size; ++a)
+                covariances_.col(i + linear_size * j).array() -= K_.col(i + linear_size * a).array() * PHt_.col(j + linear_size * a).array();
+}
+
+
+void RBPF::partitionModel()
+{
+    sampled_states_.clear();
+    for (int i = 0; i < F_.rows(); ++i)
+        if (std::find(linear_states_.begin(), linear_states_.end(), i) == linear_states_.end())
+            sampled_states_.push_back(i);
+
+    const std::vector<int>& s = sampled_states_;
+    const std::vector<int>& l = linear_states_;
+
+    const MatrixXf Q = state_model_->getNoiseCovarianceMatrix();
+    const MatrixXf R = observation_model_->getNoiseCovarianceMatrix();
+
+    const MatrixXf F_sl = submatrix(F_, s, l);
+    const MatrixXf F_ll = submatrix(F_, l, l);
+    const MatrixXf H_l  = submatrix(H_, std::vector<int>(), l);
+    const MatrixXf Q_ss = submatrix(Q, s, s);
+    const MatrixXf Q_sl = submatrix(Q, s, l);
+
+    /* G = Q_ls Q_ss^-1 */
+    const MatrixXf G = Q_ss.llt().solve(Q_sl).transpose();
+
+    F_ss_t_ = submatrix(F_, s, s).transpose();
+    F_sl_t_ = F_sl.transpose();
+    F_ls_t_ = submatrix(F_, l, s).transpose();
+    F_ll_t_ = (F_ll - G * F_sl).transpose();
+    G_t_    = G.transpose();
+    H_s_t_  = submatrix(H_, std::vector<int>(), s).transpose();
+    H_l_t_  = H_l.transpose();
+
+    Q_ss_ = vectorize(Q_ss);
+    Q_ll_ = vectorize(submatrix(Q, l, l) - G * Q_sl);
+    R_    = vectorize(R);
+
+    const MatrixXf I_l = MatrixXf::Identity(l.size(), l.size());
+
+    FF_sl_t_ = BatchKalmanFilter::kronecker(F_sl, F_sl).transpose();
+    FI_sl_t_ = BatchKalmanFilter::kronecker(F_sl, I_l).transpose();
+    FF_ll_t_ = BatchKalmanFilter::kronecker(F_ll_t_.transpose(), F_ll_t_.transpose()).transpose();
+    HH_l_t_  = BatchKalmanFilter::kronecker(H_l, H_l).transpose();
+    HI_l_t_  = BatchKalmanFilter::kronecker(H_l, I_l).transpose();
+}
+
+
+VectorXf RBPF::estimate()
+{
+    VectorXf state(F_.rows());
+
+    const VectorXf weights = log_weights_ ? VectorXf(weights_.array().exp()) : weights_;
+
+    const VectorXf sampled_mean = particles_.transpose() * weights;
+    const VectorXf linear_mean  = means_.transpose() * weights;
+
+    for (std::size_t i = 0; i < sampled_states_.size(); ++i)
+        state(sampled_states_[i]) = sampled_mean(i);
+
+    for (std::size_t i = 0; i < linear_states_.size(); ++i)
+        state(linear_states_[i]) = linear_mean(i);
+
+    return state;
+}
+
+
+MatrixXf RBPF::submatrix(const Ref<const MatrixXf>& A, const std::vector<int>& rows, const std::vector<int>& cols)
+{
+    /* An empty list of rows selects all of them */
+    const int num_rows = rows.empty() ? A.rows() : rows.size();
+
+    MatrixXf B(num_rows, cols.size());
+    for (int i = 0; i < num_rows; ++i)
+        for (std::size_t j = 0; j < cols.size(); ++j)
+            B(i, j) = A(rows.empty() ? i : rows[i], cols[j]);
+
+    return B;
+}
+
+
+RowVectorXf RBPF::vectorize(const Ref<const MatrixXf>& A)
+{
+    const MatrixXf B = A;
+
+    return Map<const RowVectorXf>(B.data(), B.size());
+}
+
+
+void RBPF::gatherRows(const Ref<const MatrixXf>& input, const Ref<const VectorXl>& ancestors, Ref<MatrixXf> output)
+{
+    /* Gather one contiguous column at a time */
+    for (int c = 0; c < input.cols(); ++c)
+        for (int j = 0; j < ancestors.size(); ++j)
+            output(j, c) = input(ancestors(j), c);
+}
@@ -0,0 +1,79 @@
+#include "BayesFilters/RejectionResampling.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+RejectionResampling::RejectionResampling(unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+RejectionResampling::RejectionResampling() noexcept :
+    Resampling(1) { }
+
+
+RejectionResampling::RejectionResampling(RejectionResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+RejectionResampling::~RejectionResampling() noexcept { }
+
+
+RejectionResampling& RejectionResampling::operator=(RejectionResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+    }
+
+    return *this;
+}
+
+
+void RejectionResampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::int64_t num_particles     = cor_weights.size();
+    const std::size_t  num_res_particles = res_ancestors.size();
+    const std::size_t  block_size        = ThreadPool::getBlockSize(1);
+    const bool         log_weights       = getLogWeights();
+
+    const float max_weight = cor_weights.maxCoeff();
+
+    /* All weights are zero: there is nothing to prefer, keep the particles. */
+    if (log_weights ? !std::isfinite(max_weight) : !(max_weight > 0.0f))
+    {
+        for (std::size_t j = 0; j < num_res_particles; ++j)
+            res_ancestors(j) = j % num_particles;
+
+        return;
+    }
+
+    const std::vector<std::uint64_t> seeds = drawBlockSeeds((num_res_particles + block_size - 1) / block_size);
+
+    ThreadPool::forEachBlock(thread_pool_, num_res_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::mt19937_64 generator(seeds[begin / block_size]);
+                                 std::uniform_int_distribution<std::int64_t> distribution_idx(0, num_particles - 1);
+                                 std::uniform_real_distribution<float> distribution_acc(0.0, 1.0);
+
+                                 for (std::size_t j = begin; j < end; ++j)
+                                 {
+                                     std::int64_t k = j % num_particles;
+                                     float        u = distribution_acc(generator);
+
+                                     while (log_weights ? (std::log(u) > cor_weights(k) - max_weight) : (u * max_weight > cor_weights(k)))
+                                     {
+                                         k = distribution_idx(generator);
+                                         u = distribution_acc(generator);
+                                     }
+
+                                     res_ancestors(j) = k;
+                                 }
+                             });
+}
@@ -1,5 +1,8 @@
 #include "BayesFilters/Resampling.h"
+#include "BayesFilters/utils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 using namespace bfl;
@@ -18,11 +21,15 @@ Resampling::~Resampling() noexcept { }
 
 
 Resampling::Resampling(const Resampling& resampling) noexcept :
-    generator_(resampling.generator_) { }
+    thread_pool_(resampling.thread_pool_),
+    generator_(resampling.generator_),
+    log_weights_(resampling.log_weights_) { }
 
 
 Resampling::Resampling(Resampling&& resampling) noexcept :
-    generator_(std::move(resampling.generator_)) { }
+    thread_pool_(std::move(resampling.thread_pool_)),
+    generator_(std::move(resampling.generator_)),
+    log_weights_(resampling.log_weights_) { }
 
 
 Resampling& Resampling::operator=(const Resampling& resampling)
@@ -36,7 +43,9 @@ Resampling& Resampling::operator=(const Resampling& resampling)
 
 Resampling& Resampling::operator=(Resampling&& resampling) noexcept
 {
-    generator_ = std::move(resampling.generator_);
+    thread_pool_ = resampling.thread_pool_;
+    generator_   = std::move(resampling.generator_);
+    log_weights_ = resampling.log_weights_;
 
     return *this;
 }
@@ -44,7 +53,9 @@ Resampling& Resampling::operator=(Resampling&& resampling) noexcept
 
 Resampling& Resampling::operator=(const Resampling&& resampling) noexcept
 {
-    generator_ = std::move(resampling.generator_);
+    thread_pool_ = resampling.thread_pool_;
+    generator_   = std::move(resampling.generator_);
+    log_weights_ = resampling.log_weights_;
 
     return *this;
 }
@@ -53,31 +64,160 @@ Resampling& Resampling::operator=(const Resampling&& resampling) noexcept
 void Resampling::resample(const Ref<const MatrixXf>& cor_particles, const Ref<const VectorXf>& cor_weights,
                           Ref<MatrixXf> res_particles, Ref<VectorXf> res_weights, Ref<VectorXf> res_parents)
 {
-    int num_particles = static_cast<int>(cor_weights.rows());
-    VectorXf csw(num_particles);
+    const std::size_t num_res_particles = res_particles.cols();
 
-    csw(0) = cor_weights(0);
-    for (int i = 1; i < num_particles; ++i)
-        csw(i) = csw(i-1) + cor_weights(i);
+    ancestors_.resize(num_res_particles);
+    ancestors(cor_weights, ancestors_);
 
-    std::uniform_real_distribution<float> distribution_res(0.0, 1.0/num_particles);
-    float u_1 = distribution_res(generator_);
+    gather(cor_particles, ancestors_, res_particles);
 
-    int idx_csw = 0;
-    for (int j = 0; j < num_particles; ++j)
-    {
-        float u_j = u_1 + static_cast<float>(j)/num_particles;
+    if (log_weights_)
+        res_weights.setConstant(-std::log(static_cast<float>(num_res_particles)));
+    else
+        res_weights.setConstant(1.0 / num_res_particles);
+
+    res_parents.head(num_res_particles) = ancestors_.cast<float>();
+}
 
-        while (u_j > csw(idx_csw)) { idx_csw += 1; }
 
-        res_particles.col(j) = cor_particles.col(idx_csw);
-        res_weights(j)       = 1.0/num_particles;
-        res_parents(j)       = idx_csw;
-    }
+void Resampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::size_t num_res_particles = res_ancestors.size();
+
+    const double total = cumulativeWeights(cor_weights, log_weights_);
+
+    std::uniform_real_distribution<double> distribution_res(0.0, 1.0);
+    const double u_1 = distribution_res(generator_);
+
+    /* Each block of output particles locates its first ancestor with a binary search, then proceeds linearly. */
+    ThreadPool::forEachBlock(thread_pool_, num_res_particles, ThreadPool::getBlockSize(1),
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::int64_t idx = -1;
+                                 for (std::size_t j = begin; j < end; ++j)
+                                 {
+                                     const double u_j = (u_1 + static_cast<double>(j)) / num_res_particles * total;
+
+                                     idx = searchCumulativeWeights(u_j, idx);
+
+                                     res_ancestors(j) = idx;
+                                 }
+                             });
+}
+
+
+void Resampling::gather(const Ref<const MatrixXf>& cor_particles, const Ref<const VectorXl>& res_ancestors, Ref<MatrixXf> res_particles)
+{
+    ThreadPool::forEachBlock(thread_pool_, res_ancestors.size(), ThreadPool::getBlockSize(cor_particles.rows()),
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 for (std::size_t j = begin; j < end; ++j)
+                                     res_particles.col(j) = cor_particles.col(res_ancestors(j));
+                             });
 }
 
 
 float Resampling::neff(const Ref<const VectorXf>& cor_weights)
 {
+    if (log_weights_)
+        return std::exp(2.0f * utils::log_sum_exp(cor_weights) - utils::log_sum_exp(2.0f * cor_weights));
+
     return 1.0/cor_weights.array().square().sum();
 }
+
+
+void Resampling::setLogWeights(const bool status)
+{
+    log_weights_ = status;
+}
+
+
+bool Resampling::getLogWeights()
+{
+    return log_weights_;
+}
+
+
+void Resampling::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    thread_pool_ = std::move(thread_pool);
+}
+
+
+double Resampling::cumulativeWeights(const Ref<const VectorXf>& weights, const bool log_weights)
+{
+    const std::size_t num_particles = weights.size();
+    const std::size_t block_size    = ThreadPool::getBlockSize(1);
+    const std::size_t num_blocks    = (num_particles + block_size - 1) / block_size;
+
+    /* Log-weights are exponentiated relative to their maximum, any scaling cancels out with the total. */
+    max_log_weight_ = log_weights ? weights.maxCoeff() : 0.0f;
+
+    cumulative_weights_.resize(num_particles);
+    block_sums_.resize(num_blocks);
+
+    /* First pass: prefix sum within each block. */
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 double sum = 0.0;
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     sum += linearWeight(weights, i, log_weights);
+                                     cumulative_weights_(i) = sum;
+                                 }
+
+                                 block_sums_(begin / block_size) = sum;
+                             });
+
+    /* Exclusive scan of the block sums. */
+    double total = 0.0;
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+        const double block_sum = block_sums_(b);
+        block_sums_(b) = total;
+        total += block_sum;
+    }
+
+    /* Second pass: add the block offsets. */
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 cumulative_weights_.segment(begin, end - begin).array() += block_sums_(begin / block_size);
+                             });
+
+    return total;
+}
+
+
+double Resampling::linearWeight(const Ref<const VectorXf>& weights, const std::size_t i, const bool log_weights) const
+{
+    if (log_weights)
+        return std::exp(static_cast<double>(weights(i) - max_log_weight_));
+
+    return static_cast<double>(weights(i));
+}
+
+
+std::int64_t Resampling::searchCumulativeWeights(const double u, std::int64_t hint) const
+{
+    const std::int64_t last = static_cast<std::int64_t>(cumulative_weights_.size()) - 1;
+
+    if (hint < 0)
+        hint = std::lower_bound(cumulative_weights_.data(), cumulative_weights_.data() + last, u) - cumulative_weights_.data();
+
+    while (hint < last && cumulative_weights_(hint) < u)
+        ++hint;
+
+    return hint;
+}
+
+
+std::vector<std::uint64_t> Resampling::drawBlockSeeds(const std::size_t num_blocks)
+{
+    std::vector<std::uint64_t> seeds(num_blocks);
+    for (std::uint64_t& seed : seeds)
+        seed = generator_();
+
+    return seeds;
+}
@@ -0,0 +1,112 @@
+#include "BayesFilters/ResamplingPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+WeightStatistics bfl::normalizeWeights(Ref<VectorXf> weights, const bool log_weights,
+                                       const std::shared_ptr<ThreadPool>& thread_pool, MatrixXd& block_statistics)
+{
+    const std::size_t num_particles = weights.size();
+    const std::size_t block_size    = ThreadPool::getBlockSize(1);
+    const std::size_t num_blocks    = (num_particles + block_size - 1) / block_size;
+
+    /* Log-weights are exponentiated relative to their maximum, linear weights are used as they are. */
+    const float max_log_weight = log_weights ? weights.maxCoeff() : 0.0f;
+
+    /* Each block accumulates sum(w), sum(w^2), sum(w * log(w)) and max(w) of the unnormalized linear weights. */
+    block_statistics.resize(4, num_blocks);
+
+    if (!log_weights || std::isfinite(max_log_weight))
+    {
+        ThreadPool::forEachBlock(thread_pool, num_particles, block_size,
+                                 [&](const std::size_t begin, const std::size_t end)
+                                 {
+                                     double sum       = 0.0;
+                                     double sum_sq    = 0.0;
+                                     double sum_w_log = 0.0;
+                                     double max       = 0.0;
+
+                                     for (std::size_t i = begin; i < end; ++i)
+                                     {
+                                         double w;
+                                         double log_w;
+                                         if (log_weights)
+                                         {
+                                             log_w = static_cast<double>(weights(i)) - max_log_weight;
+                                             w     = std::exp(log_w);
+                                         }
+                                         else
+                                         {
+                                             w     = weights(i);
+                                             log_w = w > 0.0 ? std::log(w) : 0.0;
+                                         }
+
+                                         sum    += w;
+                                         sum_sq += w * w;
+                                         if (w > 0.0)
+                                             sum_w_log += w * log_w;
+                                         max     = std::max(max, w);
+                                     }
+
+                                     block_statistics.col(begin / block_size) << sum, sum_sq, sum_w_log, max;
+                                 });
+    }
+    else
+        block_statistics.setZero();
+
+    const double sum = block_statistics.row(0).sum();
+
+    /* All the weights vanished, e.g. every log-weight is -inf: fall back to uniform weights. */
+    if (!(sum > 0.0) || !std::isfinite(sum))
+    {
+        if (log_weights)
+            weights.setConstant(-std::log(static_cast<float>(num_particles)));
+        else
+            weights.setConstant(1.0f / num_particles);
+
+        WeightStatistics statistics;
+        statistics.num_particles = num_particles;
+        statistics.ess           = num_particles;
+        statistics.entropy       = std::log(static_cast<double>(num_particles));
+        statistics.max_weight    = 1.0 / num_particles;
+
+        return statistics;
+    }
+
+    const double sum_sq    = block_statistics.row(1).sum();
+    const double sum_w_log = block_statistics.row(2).sum();
+    const double max       = block_statistics.row(3).maxCoeff();
+
+    if (log_weights)
+    {
+        const float log_sum = max_log_weight + static_cast<float>(std::log(sum));
+
+        ThreadPool::forEachBlock(thread_pool, num_particles, block_size,
+                                 [&](const std::size_t begin, const std::size_t end)
+                                 {
+                                     weights.segment(begin, end - begin).array() -= log_sum;
+                                 });
+    }
+    else
+    {
+        const float inv_sum = static_cast<float>(1.0 / sum);
+
+        ThreadPool::forEachBlock(thread_pool, num_particles, block_size,
+                                 [&](const std::size_t begin, const std::size_t end)
+                                 {
+                                     weights.segment(begin, end - begin) *= inv_sum;
+                                 });
+    }
+
+    WeightStatistics statistics;
+    statistics.num_particles = num_particles;
+    statistics.ess           = sum * sum / sum_sq;
+    statistics.entropy       = std::log(sum) - sum_w_log / sum;
+    statistics.max_weight    = max / sum;
+
+    return statistics;
+}
@@ -1,6 +1,7 @@
 #include "BayesFilters/ResamplingWithPrior.h"
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <vector>
 
@@ -53,44 +54,51 @@ ResamplingWithPrior& ResamplingWithPrior::operator=(ResamplingWithPrior&& resamp
 void ResamplingWithPrior::resample(const Ref<const MatrixXf>& pred_particles, const Ref<const VectorXf>& cor_weights,
                                    Ref<MatrixXf> res_particles, Ref<VectorXf> res_weights, Ref<VectorXf> res_parents)
 {
-    int num_prior_particles    = static_cast<int>(std::floor(pred_particles.cols() * prior_ratio_));
-    int num_resample_particles = pred_particles.cols() - num_prior_particles;
-
-    MatrixXf tmp_particles(pred_particles.rows(), num_resample_particles);
-    VectorXf tmp_weights(num_resample_particles);
-
-    int j = 0;
-    for (int i: sort_indices(cor_weights))
-    {
-        if (j < num_prior_particles)
-        {
-            res_particles.col(j) = pred_particles.col(i);
-            res_weights(j)       = cor_weights(i);
-        }
-        else
-        {
-            tmp_particles.col(j - num_prior_particles) = pred_particles.col(i);
-            tmp_weights(j - num_prior_particles)       = cor_weights(i);
-        }
-        j++;
-    }
+    const std::size_t num_particles          = pred_particles.cols();
+    const std::size_t num_low_weights        = static_cast<std::size_t>(std::floor(num_particles * prior_ratio_));
+    const std::size_t num_high_weights       = num_particles - num_low_weights;
+
+    const std::size_t num_res_particles      = res_particles.cols();
+    const std::size_t num_prior_particles    = static_cast<std::size_t>(std::floor(num_res_particles * prior_ratio_));
+    const std::size_t num_resample_particles = num_res_particles - num_prior_particles;
+
+    /* Partition the indices so that the last num_high_weights ones refer to the highest weights. */
+    indices_.resize(num_particles);
+    std::iota(indices_.begin(), indices_.end(), 0);
+
+    std::nth_element(indices_.begin(), indices_.begin() + num_low_weights, indices_.end(),
+                     [&cor_weights](const std::int64_t i, const std::int64_t j) { return cor_weights(i) < cor_weights(j); });
+
+    high_weights_.resize(num_high_weights);
+    ThreadPool::forEachBlock(thread_pool_, num_high_weights, ThreadPool::getBlockSize(1),
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 for (std::size_t k = begin; k < end; ++k)
+                                     high_weights_(k) = cor_weights(indices_[num_low_weights + k]);
+                             });
+
+    /* Weights need not be normalized to draw the ancestors. */
+    ancestors_.resize(num_resample_particles);
+    ancestors(high_weights_, ancestors_);
+
+    ThreadPool::forEachBlock(thread_pool_, num_resample_particles, ThreadPool::getBlockSize(pred_particles.rows()),
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 for (std::size_t j = begin; j < end; ++j)
+                                 {
+                                     const std::int64_t parent = indices_[num_low_weights + ancestors_(j)];
+
+                                     res_particles.col(num_prior_particles + j) = pred_particles.col(parent);
+                                     res_parents(num_prior_particles + j)       = parent;
+                                 }
+                             });
 
     init_model_->initialize(res_particles.leftCols(num_prior_particles), res_weights.head(num_prior_particles));
 
-    Resampling::resample(tmp_particles, tmp_weights / tmp_weights.sum(),
-                         res_particles.rightCols(num_resample_particles), res_weights.tail(num_resample_particles), res_parents);
-
-    res_weights.setConstant(1.0 / pred_particles.cols());
-}
-
-
-std::vector<unsigned int> ResamplingWithPrior::sort_indices(const Ref<const VectorXf>& vector)
-{
-    std::vector<unsigned int> idx(vector.size());
-    std::iota(idx.begin(), idx.end(), 0);
-
-    std::sort(idx.begin(), idx.end(),
-              [&vector](size_t idx1, size_t idx2) { return vector[idx1] < vector[idx2]; });
+    res_parents.head(num_prior_particles).setConstant(-1);
 
-    return idx;
+    if (getLogWeights())
+        res_weights.setConstant(-std::log(static_cast<float>(num_res_particles)));
+    else
+        res_weights.setConstant(1.0 / num_res_particles);
 }
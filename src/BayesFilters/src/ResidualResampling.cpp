@@ -0,0 +1,107 @@
+#include "BayesFilters/ResidualResampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+ResidualResampling::ResidualResampling(unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+ResidualResampling::ResidualResampling() noexcept :
+    Resampling(1) { }
+
+
+ResidualResampling::ResidualResampling(ResidualResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+ResidualResampling::~ResidualResampling() noexcept { }
+
+
+ResidualResampling& ResidualResampling::operator=(ResidualResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+    }
+
+    return *this;
+}
+
+
+void ResidualResampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::size_t num_particles     = cor_weights.size();
+    const std::size_t num_res_particles = res_ancestors.size();
+    const std::size_t block_size        = ThreadPool::getBlockSize(1);
+    const std::size_t num_blocks        = (num_particles + block_size - 1) / block_size;
+    const bool        log_weights       = getLogWeights();
+
+    const double total = cumulativeWeights(cor_weights, log_weights);
+
+    num_copies_.resize(num_particles);
+    residual_weights_.resize(num_particles);
+    VectorXl block_offsets(num_blocks);
+
+    /* Deterministic number of copies and residual weight of each particle. */
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::int64_t block_copies = 0;
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     const double expected_copies = num_res_particles * linearWeight(cor_weights, i, log_weights) / total;
+
+                                     num_copies_(i)       = static_cast<std::int64_t>(std::floor(expected_copies));
+                                     residual_weights_(i) = static_cast<float>(expected_copies - num_copies_(i));
+
+                                     block_copies += num_copies_(i);
+                                 }
+
+                                 block_offsets(begin / block_size) = block_copies;
+                             });
+
+    std::int64_t num_copies = 0;
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+        const std::int64_t block_copies = block_offsets(b);
+        block_offsets(b) = num_copies;
+        num_copies += block_copies;
+    }
+    num_copies = std::min<std::int64_t>(num_copies, num_res_particles);
+
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::int64_t j = block_offsets(begin / block_size);
+                                 for (std::size_t i = begin; i < end; ++i)
+                                     for (std::int64_t c = 0; c < num_copies_(i) && j < num_copies; ++c)
+                                         res_ancestors(j++) = i;
+                             });
+
+    /* Multinomial resampling of the residual weights for the remaining ancestors. */
+    const std::size_t num_residuals = num_res_particles - num_copies;
+    if (num_residuals == 0)
+        return;
+
+    const double total_residual = cumulativeWeights(residual_weights_, false);
+
+    const std::vector<std::uint64_t> seeds = drawBlockSeeds((num_residuals + block_size - 1) / block_size);
+
+    ThreadPool::forEachBlock(thread_pool_, num_residuals, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::mt19937_64 generator(seeds[begin / block_size]);
+                                 std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+                                 for (std::size_t j = begin; j < end; ++j)
+                                     res_ancestors(num_copies + j) = searchCumulativeWeights(distribution(generator) * total_residual, -1);
+                             });
+}
@@ -1,7 +1,9 @@
 #include "BayesFilters/SIS.h"
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
 #include <Eigen/Dense>
@@ -37,74 +39,141 @@ void SIS::initialization()
     surv_y_          = 1000;
 
     /* GENERATE MEASUREMENTS */
-    measurement_.resize(2, simulation_time_);
-    object_.resize(4, simulation_time_);
-
-    object_.col(0) << 0, 10, 0, 10;
-    correction_->getObservationModel().measure(object_.col(0), measurement_.col(0));
-    for (int k = 1; k < simulation_time_; ++k)
+    if (measurement_driven_)
+    {
+        /* step(measurement) writes each measurement in the only column. */
+        measurement_.setZero(2, 1);
+        object_.resize(4, 0);
+    }
+    else
     {
-        prediction_->getStateModel().motion(object_.col(k-1), object_.col(k));
-        correction_->getObservationModel().measure(object_.col(k), measurement_.col(k));
+        measurement_.resize(2, simulation_time_);
+        object_.resize(4, simulation_time_);
+
+        object_.col(0) << 0, 10, 0, 10;
+        correction_->getObservationModel().measure(object_.col(0), measurement_.col(0));
+        for (int k = 1; k < simulation_time_; ++k)
+        {
+            prediction_->getStateModel().motion(object_.col(k-1), object_.col(k));
+            correction_->getObservationModel().measure(object_.col(k), measurement_.col(k));
+        }
     }
 
     /* INITIALIZE FILTER */
+    prediction_->resetNoise();
+
     pred_particle_.resize(4, num_particle_);
     pred_weight_.resize(num_particle_, 1);
 
     cor_particle_.resize(4, num_particle_);
     cor_weight_.resize(num_particle_, 1);
 
-    pred_weight_.setConstant(1.0/num_particle_);
+    res_particle_.resize(4, num_particle_);
+    res_weight_.resize(num_particle_, 1);
+    res_parent_.resize(num_particle_, 1);
+
+    if (log_weights_)
+        pred_weight_.setConstant(-std::log(static_cast<float>(num_particle_)));
+    else
+        pred_weight_.setConstant(1.0/num_particle_);
 
     int particle_spread = std::sqrt(num_particle_);
     for (int i = 0; i < particle_spread; ++i)
         for (int j = 0; j < particle_spread; ++j)
             pred_particle_.col(i*particle_spread + j) << (surv_x_ / particle_spread) * i, 0, (surv_y_ / particle_spread) * j, 0;
 
-    result_pred_particle_.resize(simulation_time_);
-    result_pred_weight_.resize(simulation_time_);
+    const int num_results = measurement_driven_ ? 0 : simulation_time_;
+    result_pred_particle_.resize(num_results);
+    result_pred_weight_.resize(num_results);
 
-    result_cor_particle_.resize(simulation_time_);
-    result_cor_weight_.resize(simulation_time_);
+    result_cor_particle_.resize(num_results);
+    result_cor_weight_.resize(num_results);
 }
 
 
 void SIS::filteringStep()
 {
     unsigned int k = getFilteringStep();
+    const Ref<const VectorXf> measurement = measurement_.col(measurement_driven_ ? 0 : k);
+
+    updateKLDSampling();
 
     if (k != 0)
+    {
+        prediction_->setMeasurement(measurement);
         prediction_->predict(cor_particle_, cor_weight_,
                              pred_particle_, pred_weight_);
+    }
 
-    correction_->correct(pred_particle_, pred_weight_, measurement_.col(k),
+    correction_->correct(pred_particle_, pred_weight_, measurement,
                          cor_particle_, cor_weight_);
 
-    cor_weight_ /= cor_weight_.sum();
+    const WeightStatistics statistics = normalizeWeights(cor_weight_);
+
+    updateEstimate();
 
 
     /* Here results should be save. */
     /* Proper stragy is WIP. */
-    result_pred_particle_[k] = pred_particle_;
-    result_pred_weight_  [k] = pred_weight_;
+    if (!measurement_driven_)
+    {
+        result_pred_particle_[k] = pred_particle_;
+        result_pred_weight_  [k] = pred_weight_;
+
+        result_cor_particle_[k]  = cor_particle_;
+        result_cor_weight_  [k]  = cor_weight_;
+    }
 
-    result_cor_particle_[k]  = cor_particle_;
-    result_cor_weight_  [k]  = cor_weight_;
 
+    if (kld_sampling_)
+        num_particle_req_ = kld_sampling_->numParticles(cor_particle_);
 
-    if (resampling_->neff(cor_weight_) < static_cast<float>(num_particle_)/3.0)
+    const int num_particle_req = num_particle_req_;
+    const int num_res_particle = num_particle_req > 0 ? num_particle_req : num_particle_;
+
+    /* Changing the number of particles requires resampling them. */
+    if (num_res_particle != num_particle_ || resampling_policy_->resample(statistics, k))
     {
-        MatrixXf res_particle(4, num_particle_);
-        VectorXf res_weight(num_particle_, 1);
-        VectorXf res_parent(num_particle_, 1);
+        res_particle_.resize(cor_particle_.rows(), num_res_particle);
+        res_weight_.resize(num_res_particle, 1);
+        res_parent_.resize(num_res_particle, 1);
 
         resampling_->resample(cor_particle_, cor_weight_,
-                              res_particle, res_weight, res_parent);
+                              res_particle_, res_weight_, res_parent_);
+
+        cor_particle_.swap(res_particle_);
+        cor_weight_.swap(res_weight_);
+
+        if (num_res_particle != num_particle_)
+        {
+            num_particle_ = num_res_particle;
+
+            pred_particle_.resize(cor_particle_.rows(), num_particle_);
+            pred_weight_.resize(num_particle_, 1);
+        }
+    }
+}
 
-        cor_particle_ = res_particle;
-        cor_weight_   = res_weight;
+
+const VectorXf& SIS::step(const Ref<const VectorXf>& measurement)
+{
+    if (!measurement_driven_)
+    {
+        measurement_driven_ = true;
+        reset();
     }
+
+    if (!prepareStep())
+        throw std::runtime_error("ERROR::SIS::STEP\nERROR:\n\tThe filter cannot run further steps.");
+
+    if (measurement.size() != measurement_.rows())
+        throw std::runtime_error("ERROR::SIS::STEP\nERROR:\n\tMeasurement size does not match the observation model.");
+
+    measurement_.col(0) = measurement;
+
+    FilteringAlgorithm::step();
+
+    return estimate_;
 }
 
 
@@ -126,7 +195,7 @@ void SIS::getResult()
 
     result_file_object       << object_;
     result_file_measurement  << measurement_;
-    for (unsigned int k = 0; k < getFilteringStep(); ++k)
+    for (unsigned int k = 0; k < (measurement_driven_ ? 0 : getFilteringStep()); ++k)
     {
         result_file_pred_particle << result_pred_particle_[k] << std::endl << std::endl;
         result_file_pred_weight   << result_pred_weight_[k]   << std::endl << std::endl;
@@ -142,3 +211,43 @@ void SIS::getResult()
     result_file_cor_particle.close();
     result_file_cor_weight.close();
 }
+
+
+void SIS::setNumParticles(const int num_particles)
+{
+    num_particle_req_ = num_particles;
+}
+
+
+int SIS::getNumParticles()
+{
+    return num_particle_;
+}
+
+
+void SIS::setKLDSampling(std::unique_ptr<KLDSampling> kld_sampling)
+{
+    std::lock_guard<std::mutex> lk(mtx_kld_sampling_);
+    kld_sampling_req_     = std::move(kld_sampling);
+    kld_sampling_changed_ = true;
+}
+
+
+void SIS::updateEstimate()
+{
+    if (log_weights_)
+        estimate_.noalias() = cor_particle_ * cor_weight_.array().exp().matrix();
+    else
+        estimate_.noalias() = cor_particle_ * cor_weight_;
+}
+
+
+void SIS::updateKLDSampling()
+{
+    std::lock_guard<std::mutex> lk(mtx_kld_sampling_);
+    if (kld_sampling_changed_)
+    {
+        kld_sampling_         = std::move(kld_sampling_req_);
+        kld_sampling_changed_ = false;
+    }
+}
@@ -0,0 +1,223 @@
+#include "BayesFilters/SigmaPointTransform.h"
+
+#include <cmath>
+#include <utility>
+
+#include <Eigen/Eigenvalues>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+SigmaPointTransform::SigmaPointTransform(const unsigned int dim, const double alpha, const double beta, const double kappa) noexcept :
+    type_(Type::unscented),
+    dim_(dim)
+{
+    unscentedPoints(alpha, beta, kappa);
+}
+
+
+SigmaPointTransform::SigmaPointTransform(const unsigned int dim, const Type type) noexcept :
+    type_(type),
+    dim_(dim)
+{
+    switch (type_)
+    {
+        case Type::unscented:
+            unscentedPoints(1.0, 2.0, 0.0);
+            break;
+
+        case Type::cubature:
+            cubaturePoints();
+            break;
+
+        case Type::gauss_hermite:
+            gaussHermitePoints(3);
+            break;
+    }
+}
+
+
+SigmaPointTransform::SigmaPointTransform(const unsigned int dim, const unsigned int order) noexcept :
+    type_(Type::gauss_hermite),
+    dim_(dim)
+{
+    gaussHermitePoints(order);
+}
+
+
+SigmaPointTransform::SigmaPointTransform(SigmaPointTransform&& transform) noexcept :
+    type_(transform.type_),
+    dim_(transform.dim_),
+    unit_points_(std::move(transform.unit_points_)),
+    mean_weights_(std::move(transform.mean_weights_)),
+    covariance_weights_(std::move(transform.covariance_weights_)) { }
+
+
+SigmaPointTransform::~SigmaPointTransform() noexcept { }
+
+
+SigmaPointTransform& SigmaPointTransform::operator=(SigmaPointTransform&& transform) noexcept
+{
+    type_               = transform.type_;
+    dim_                = transform.dim_;
+    unit_points_        = std::move(transform.unit_points_);
+    mean_weights_       = std::move(transform.mean_weights_);
+    covariance_weights_ = std::move(transform.covariance_weights_);
+
+    return *this;
+}
+
+
+SigmaPointTransform::Type SigmaPointTransform::getType() const
+{
+    return type_;
+}
+
+
+unsigned int SigmaPointTransform::getDimension() const
+{
+    return dim_;
+}
+
+
+unsigned int SigmaPointTransform::getNumSigmaPoints() const
+{
+    return unit_points_.cols();
+}
+
+
+const VectorXf& SigmaPointTransform::getMeanWeights() const
+{
+    return mean_weights_;
+}
+
+
+const VectorXf& SigmaPointTransform::getCovarianceWeights() const
+{
+    return covariance_weights_;
+}
+
+
+void SigmaPointTransform::sigmaPoints(const Ref<const VectorXf>& mean, const Ref<const MatrixXf>& covariance, Ref<MatrixXf> sigma_points)
+{
+    covariance_llt_.compute(covariance);
+
+    sigma_points.noalias() = covariance_llt_.matrixL() * unit_points_;
+    sigma_points.colwise() += mean;
+}
+
+
+void SigmaPointTransform::moments(const Ref<const MatrixXf>& points, Ref<VectorXf> mean, Ref<MatrixXf> covariance, Ref<MatrixXf> deviations)
+{
+    mean.noalias() = points * mean_weights_;
+
+    deviations = points.colwise() - mean;
+    covariance.noalias() = deviations * covariance_weights_.asDiagonal() * deviations.transpose();
+}
+
+
+void SigmaPointTransform::propagate(StateModel& state_model, const Ref<const VectorXf>& mean, const Ref<const MatrixXf>& covariance,
+                                    Ref<VectorXf> prop_mean, Ref<MatrixXf> prop_covariance)
+{
+    sigma_points_.resize(dim_, unit_points_.cols());
+    sigmaPoints(mean, covariance, sigma_points_);
+
+    prop_points_.resize(dim_, unit_points_.cols());
+    state_model.propagate(sigma_points_, prop_points_);
+
+    prop_deviations_.resize(dim_, unit_points_.cols());
+    moments(prop_points_, prop_mean, prop_covariance, prop_deviations_);
+}
+
+
+void SigmaPointTransform::observe(ObservationModel& observation_model, const Ref<const VectorXf>& mean, const Ref<const MatrixXf>& covariance,
+                                  Ref<VectorXf> obs_mean, Ref<MatrixXf> obs_covariance, Ref<MatrixXf> cross_covariance)
+{
+    sigma_points_.resize(dim_, unit_points_.cols());
+    sigmaPoints(mean, covariance, sigma_points_);
+
+    obs_points_.resize(obs_mean.size(), unit_points_.cols());
+    observation_model.observe(sigma_points_, obs_points_);
+
+    obs_deviations_.resize(obs_mean.size(), unit_points_.cols());
+    moments(obs_points_, obs_mean, obs_covariance, obs_deviations_);
+
+    state_deviations_ = sigma_points_.colwise() - mean;
+    cross_covariance.noalias() = state_deviations_ * covariance_weights_.asDiagonal() * obs_deviations_.transpose();
+}
+
+
+const MatrixXf& SigmaPointTransform::getSigmaPoints() const
+{
+    return sigma_points_;
+}
+
+
+void SigmaPointTransform::unscentedPoints(const double alpha, const double beta, const double kappa)
+{
+    const double lambda = alpha * alpha * (dim_ + kappa) - dim_;
+    const double scale  = std::sqrt(dim_ + lambda);
+
+    unit_points_.setZero(dim_, 2 * dim_ + 1);
+    unit_points_.block(0, 1,        dim_, dim_).diagonal().setConstant( scale);
+    unit_points_.block(0, 1 + dim_, dim_, dim_).diagonal().setConstant(-scale);
+
+    mean_weights_.setConstant(2 * dim_ + 1, 1.0 / (2.0 * (dim_ + lambda)));
+    mean_weights_(0) = lambda / (dim_ + lambda);
+
+    covariance_weights_    = mean_weights_;
+    covariance_weights_(0) = mean_weights_(0) + (1.0 - alpha * alpha + beta);
+}
+
+
+void SigmaPointTransform::cubaturePoints()
+{
+    const double scale = std::sqrt(static_cast<double>(dim_));
+
+    unit_points_.setZero(dim_, 2 * dim_);
+    unit_points_.leftCols(dim_).diagonal().setConstant( scale);
+    unit_points_.rightCols(dim_).diagonal().setConstant(-scale);
+
+    mean_weights_.setConstant(2 * dim_, 1.0 / (2.0 * dim_));
+    covariance_weights_ = mean_weights_;
+}
+
+
+void SigmaPointTransform::gaussHermitePoints(const unsigned int order)
+{
+    /* One-dimensional nodes and weights for N(0, 1) by the Golub-Welsch algorithm. */
+    MatrixXd jacobi = MatrixXd::Zero(order, order);
+    for (unsigned int i = 1; i < order; ++i)
+    {
+        jacobi(i, i - 1) = std::sqrt(static_cast<double>(i));
+        jacobi(i - 1, i) = jacobi(i, i - 1);
+    }
+
+    SelfAdjointEigenSolver<MatrixXd> eigen_solver(jacobi);
+    const VectorXd nodes   = eigen_solver.eigenvalues();
+    const VectorXd weights = eigen_solver.eigenvectors().row(0).transpose().array().square();
+
+    /* Tensor product over the dimensions. */
+    unsigned int num_points = 1;
+    for (unsigned int d = 0; d < dim_; ++d)
+        num_points *= order;
+
+    unit_points_.resize(dim_, num_points);
+    mean_weights_.resize(num_points);
+    for (unsigned int j = 0; j < num_points; ++j)
+    {
+        double weight = 1.0;
+        unsigned int index = j;
+        for (unsigned int d = 0; d < dim_; ++d)
+        {
+            unit_points_(d, j) = nodes(index % order);
+            weight *= weights(index % order);
+            index /= order;
+        }
+
+        mean_weights_(j) = weight;
+    }
+
+    covariance_weights_ = mean_weights_;
+}
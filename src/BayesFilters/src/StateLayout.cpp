@@ -0,0 +1,82 @@
+#include "BayesFilters/StateLayout.h"
+
+#include <utility>
+
+using namespace bfl;
+
+
+StateLayout::StateLayout() noexcept { }
+
+
+StateLayout::StateLayout(const unsigned int linear_size) noexcept
+{
+    addBlock(BlockType::linear, linear_size);
+}
+
+
+StateLayout::StateLayout(const StateLayout& state_layout) :
+    size_(state_layout.size_),
+    blocks_(state_layout.blocks_) { }
+
+
+StateLayout::StateLayout(StateLayout&& state_layout) noexcept :
+    size_(state_layout.size_),
+    blocks_(std::move(state_layout.blocks_))
+{
+    state_layout.size_ = 0;
+}
+
+
+StateLayout::~StateLayout() noexcept { }
+
+
+StateLayout& StateLayout::operator=(const StateLayout& state_layout)
+{
+    size_   = state_layout.size_;
+    blocks_ = state_layout.blocks_;
+
+    return *this;
+}
+
+
+StateLayout& StateLayout::operator=(StateLayout&& state_layout) noexcept
+{
+    if (this != &state_layout)
+    {
+        size_   = state_layout.size_;
+        blocks_ = std::move(state_layout.blocks_);
+
+        state_layout.size_ = 0;
+    }
+
+    return *this;
+}
+
+
+bool StateLayout::addBlock(const BlockType type, const unsigned int size)
+{
+    if (size == 0 || (type == BlockType::quaternion && size != 4))
+        return false;
+
+    Block block;
+    block.type   = type;
+    block.offset = size_;
+    block.size   = size;
+
+    blocks_.push_back(block);
+    size_ += size;
+
+    return true;
+}
+
+
+unsigned int StateLayout::getSize() const
+{
+    return size_;
+}
+
+
+const std::vector<StateLayout::Block>& StateLayout::getBlocks() const
+{
+    return blocks_;
+}
@@ -35,6 +35,13 @@ void StateModelDecorator::motion(const Ref<const MatrixXf>& cur_states, Ref<Matr
 }
 
 
+void StateModelDecorator::keyedMotion(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf> mot_states,
+                                      const std::uint64_t step, const std::uint64_t first_state)
+{
+    state_model_->keyedMotion(cur_states, mot_states, step, first_state);
+}
+
+
 MatrixXf StateModelDecorator::getNoiseSample(const int num)
 {
     return state_model_->getNoiseSample(num);
@@ -0,0 +1,339 @@
+#include "BayesFilters/StatisticsExtraction.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+StatisticsExtraction::StatisticsExtraction() noexcept { }
+
+
+StatisticsExtraction::StatisticsExtraction(StatisticsExtraction&& statistics_extraction) noexcept :
+    extraction_method_(statistics_extraction.extraction_method_),
+    probabilities_(std::move(statistics_extraction.probabilities_)),
+    credible_level_(statistics_extraction.credible_level_),
+    thread_pool_(std::move(statistics_extraction.thread_pool_)),
+    mean_(std::move(statistics_extraction.mean_)),
+    covariance_(std::move(statistics_extraction.covariance_)),
+    quantiles_(std::move(statistics_extraction.quantiles_)),
+    credible_intervals_(std::move(statistics_extraction.credible_intervals_)),
+    buffers_(std::move(statistics_extraction.buffers_))
+{ }
+
+
+StatisticsExtraction& StatisticsExtraction::operator=(StatisticsExtraction&& statistics_extraction) noexcept
+{
+    if (this != &statistics_extraction)
+    {
+        extraction_method_  = statistics_extraction.extraction_method_;
+        probabilities_      = std::move(statistics_extraction.probabilities_);
+        credible_level_     = statistics_extraction.credible_level_;
+        thread_pool_        = std::move(statistics_extraction.thread_pool_);
+        mean_               = std::move(statistics_extraction.mean_);
+        covariance_         = std::move(statistics_extraction.covariance_);
+        quantiles_          = std::move(statistics_extraction.quantiles_);
+        credible_intervals_ = std::move(statistics_extraction.credible_intervals_);
+        buffers_            = std::move(statistics_extraction.buffers_);
+    }
+
+    return *this;
+}
+
+
+bool StatisticsExtraction::setMethod(const ExtractionMethod& extraction_method)
+{
+    extraction_method_ = extraction_method;
+
+    return true;
+}
+
+
+bool StatisticsExtraction::setQuantiles(const std::vector<double>& probabilities)
+{
+    for (const double probability : probabilities)
+    {
+        if (!(probability >= 0.0 && probability <= 1.0))
+            return false;
+    }
+
+    probabilities_ = probabilities;
+
+    return true;
+}
+
+
+bool StatisticsExtraction::setCredibleLevel(const double level)
+{
+    if (!(level > 0.0 && level < 1.0))
+        return false;
+
+    credible_level_ = level;
+
+    return true;
+}
+
+
+void StatisticsExtraction::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+    thread_pool_ = std::move(thread_pool);
+}
+
+
+void StatisticsExtraction::extract(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights)
+{
+    if (particles.cols() != weights.size())
+        throw std::runtime_error("ERROR::STATISTICSEXTRACTION::EXTRACT\nERROR:\n\tNumber of particles and weights do not match.");
+
+    if (particles.cols() == 0)
+        throw std::runtime_error("ERROR::STATISTICSEXTRACTION::EXTRACT\nERROR:\n\tEmpty particle set.");
+
+    const std::size_t size = particles.rows();
+    const std::size_t num_particles = particles.cols();
+
+    const bool with_covariance = (extraction_method_ == ExtractionMethod::covariance || extraction_method_ == ExtractionMethod::full);
+    const bool with_quantiles  = (extraction_method_ == ExtractionMethod::quantiles  || extraction_method_ == ExtractionMethod::full);
+
+
+    /* Moments of each block, summed in block order so that the result does
+     * not depend on the thread pool. */
+    const VectorXd shift = particles.col(0).cast<double>();
+
+    const std::size_t block_size = ThreadPool::getBlockSize(size);
+    const std::size_t num_blocks = (num_particles + block_size - 1) / block_size;
+
+    std::vector<double> block_weight_sums(num_blocks);
+    MatrixXd block_first_moments(size, num_blocks);
+    std::vector<MatrixXd> block_second_moments(with_covariance ? num_blocks : 0, MatrixXd(size, size));
+
+    auto moments_kernel = [&](const std::size_t begin, const std::size_t end)
+    {
+        const std::size_t block = begin / block_size;
+
+        if (with_covariance)
+            accumulateMoments(particles, weights, shift, begin, end, block_weight_sums[block], block_first_moments.col(block), block_second_moments[block]);
+        else
+        {
+            MatrixXd no_second_moment(0, 0);
+            accumulateMoments(particles, weights, shift, begin, end, block_weight_sums[block], block_first_moments.col(block), no_second_moment);
+        }
+    };
+
+    ThreadPool::forEachBlock(thread_pool_, num_particles, block_size, moments_kernel);
+
+    const double weight_sum = std::accumulate(block_weight_sums.begin(), block_weight_sums.end(), 0.0);
+    if (!(weight_sum > 0.0))
+        throw std::runtime_error("ERROR::STATISTICSEXTRACTION::EXTRACT\nERROR:\n\tWeights must have a positive sum.");
+
+    const VectorXd first_moment = block_first_moments.rowwise().sum() / weight_sum;
+
+    mean_ = (shift + first_moment).cast<float>();
+
+    if (with_covariance)
+    {
+        MatrixXd second_moment = MatrixXd::Zero(size, size);
+        for (const MatrixXd& block_second_moment : block_second_moments)
+            second_moment += block_second_moment;
+        second_moment /= weight_sum;
+
+        second_moment.triangularView<StrictlyUpper>() = second_moment.transpose();
+
+        covariance_ = (second_moment - first_moment * first_moment.transpose()).cast<float>();
+    }
+    else
+        covariance_.resize(0, 0);
+
+
+    if (!with_quantiles)
+    {
+        quantiles_.resize(0, 0);
+        credible_intervals_.resize(0, 0);
+
+        return;
+    }
+
+    /* Quantiles and credible interval bounds are found together, visiting
+     * the probabilities in increasing order. */
+    std::vector<double> probabilities = probabilities_;
+    probabilities.push_back((1.0 - credible_level_) / 2.0);
+    probabilities.push_back((1.0 + credible_level_) / 2.0);
+
+    std::vector<std::size_t> order(probabilities.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&probabilities](const std::size_t a, const std::size_t b) { return probabilities[a] < probabilities[b]; });
+
+    std::vector<double> sorted_probabilities(probabilities.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+        sorted_probabilities[k] = probabilities[order[k]];
+
+    buffers_.resize(size);
+    MatrixXf sorted_quantiles(probabilities.size(), size);
+
+    auto quantiles_kernel = [&](const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            componentQuantiles(particles.row(i), weights, sorted_probabilities, buffers_[i], sorted_quantiles.col(i));
+    };
+
+    ThreadPool::forEachBlock(thread_pool_, size, 1, quantiles_kernel);
+
+    quantiles_.resize(size, probabilities_.size());
+    credible_intervals_.resize(size, 2);
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+        if (order[k] < probabilities_.size())
+            quantiles_.col(order[k]) = sorted_quantiles.row(k).transpose();
+        else
+            credible_intervals_.col(order[k] - probabilities_.size()) = sorted_quantiles.row(k).transpose();
+    }
+}
+
+
+const VectorXf& StatisticsExtraction::getMean() const
+{
+    return mean_;
+}
+
+
+const MatrixXf& StatisticsExtraction::getCovariance() const
+{
+    return covariance_;
+}
+
+
+const MatrixXf& StatisticsExtraction::getQuantiles() const
+{
+    return quantiles_;
+}
+
+
+const MatrixXf& StatisticsExtraction::getCredibleIntervals() const
+{
+    return credible_intervals_;
+}
+
+
+std::vector<std::string> StatisticsExtraction::getInfo() const
+{
+    std::vector<std::string> info;
+
+    info.push_back("<| Credible level: " + std::to_string(credible_level_) + " |>");
+    info.push_back("<| Available statistics extraction methods: " +
+                   std::string(extraction_method_ == ExtractionMethod::mean       ? "1) mean <-- In use; "       : "1) mean; "      ) +
+                   std::string(extraction_method_ == ExtractionMethod::covariance ? "2) covariance <-- In use; " : "2) covariance; ") +
+                   std::string(extraction_method_ == ExtractionMethod::quantiles  ? "3) quantiles <-- In use; "  : "3) quantiles; " ) +
+                   std::string(extraction_method_ == ExtractionMethod::full       ? "4) full <-- In use"         : "4) full"        ) + " |>");
+
+    return info;
+}
+
+
+void StatisticsExtraction::accumulateMoments(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights,
+                                             const Ref<const VectorXd>& shift, const std::size_t begin, const std::size_t end,
+                                             double& weight_sum, Ref<VectorXd> first_moment, Ref<MatrixXd> second_moment) const
+{
+    const std::size_t count = end - begin;
+
+    const MatrixXd deviations = particles.middleCols(begin, count).cast<double>().colwise() - shift;
+    const VectorXd block_weights = weights.segment(begin, count).cast<double>();
+
+    weight_sum = block_weights.sum();
+    first_moment.noalias() = deviations * block_weights;
+
+    if (second_moment.size() > 0)
+    {
+        /* Lower triangle of sum_j w_j d_j d_j' as a symmetric rank update. */
+        second_moment.setZero();
+        second_moment.selfadjointView<Lower>().rankUpdate(deviations * block_weights.cwiseSqrt().asDiagonal());
+    }
+}
+
+
+void StatisticsExtraction::componentQuantiles(const Ref<const RowVectorXf>& values, const Ref<const VectorXf>& weights,
+                                              const std::vector<double>& probabilities, std::vector<std::pair<float, double>>& buffer, Ref<VectorXf> quantiles) const
+{
+    buffer.clear();
+
+    double total_weight = 0.0;
+    for (int j = 0; j < values.size(); ++j)
+    {
+        if (weights(j) > 0.0f)
+        {
+            buffer.emplace_back(values(j), weights(j));
+            total_weight += weights(j);
+        }
+    }
+
+    /* The values before the previous quantile are smaller than the next
+     * quantiles, hence each selection resumes from the previous one. */
+    std::size_t begin = 0;
+    double weight_before = 0.0;
+
+    for (std::size_t k = 0; k < probabilities.size(); ++k)
+    {
+        double weight_skipped = 0.0;
+        begin = weightedSelect(buffer, begin, buffer.size(), probabilities[k] * total_weight - weight_before, weight_skipped);
+
+        quantiles(k) = buffer[begin].first;
+        weight_before += weight_skipped;
+    }
+}
+
+
+std::size_t StatisticsExtraction::weightedSelect(std::vector<std::pair<float, double>>& buffer, std::size_t begin, std::size_t end, double target, double& weight_before)
+{
+    weight_before = 0.0;
+
+    while (true)
+    {
+        /* Median of three pivot. */
+        const float a = buffer[begin].first;
+        const float b = buffer[begin + (end - begin) / 2].first;
+        const float c = buffer[end - 1].first;
+        const float pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        /* Three-way partition: [begin, less) < pivot, [less, greater) == pivot, [greater, end) > pivot. */
+        std::size_t less = begin;
+        std::size_t greater = end;
+        std::size_t i = begin;
+        double weight_less = 0.0;
+        double weight_equal = 0.0;
+
+        while (i < greater)
+        {
+            if (buffer[i].first < pivot)
+            {
+                weight_less += buffer[i].second;
+                std::swap(buffer[less++], buffer[i++]);
+            }
+            else if (buffer[i].first > pivot)
+                std::swap(buffer[i], buffer[--greater]);
+            else
+            {
+                weight_equal += buffer[i].second;
+                ++i;
+            }
+        }
+
+        if (target <= weight_less && less > begin)
+        {
+            end = less;
+            continue;
+        }
+
+        /* Also stop at the largest value if rounding leaves some target weight. */
+        if (target <= weight_less + weight_equal || greater == end)
+        {
+            weight_before += weight_less;
+
+            return less;
+        }
+
+        target -= weight_less + weight_equal;
+        weight_before += weight_less + weight_equal;
+        begin = greater;
+    }
+}
@@ -0,0 +1,63 @@
+#include "BayesFilters/StratifiedResampling.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+StratifiedResampling::StratifiedResampling(unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+StratifiedResampling::StratifiedResampling() noexcept :
+    Resampling(1) { }
+
+
+StratifiedResampling::StratifiedResampling(StratifiedResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+StratifiedResampling::~StratifiedResampling() noexcept { }
+
+
+StratifiedResampling& StratifiedResampling::operator=(StratifiedResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+    }
+
+    return *this;
+}
+
+
+void StratifiedResampling::ancestors(const Ref<const VectorXf>& cor_weights, Ref<VectorXl> res_ancestors)
+{
+    const std::size_t num_res_particles = res_ancestors.size();
+    const std::size_t block_size        = ThreadPool::getBlockSize(1);
+
+    const double total = cumulativeWeights(cor_weights, getLogWeights());
+
+    const std::vector<std::uint64_t> seeds = drawBlockSeeds((num_res_particles + block_size - 1) / block_size);
+
+    /* The sampling points are increasing, each block binary-searches its first ancestor only. */
+    ThreadPool::forEachBlock(thread_pool_, num_res_particles, block_size,
+                             [&](const std::size_t begin, const std::size_t end)
+                             {
+                                 std::mt19937_64 generator(seeds[begin / block_size]);
+                                 std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+                                 std::int64_t idx = -1;
+                                 for (std::size_t j = begin; j < end; ++j)
+                                 {
+                                     const double u_j = (static_cast<double>(j) + distribution(generator)) / num_res_particles * total;
+
+                                     idx = searchCumulativeWeights(u_j, idx);
+
+                                     res_ancestors(j) = idx;
+                                 }
+                             });
+}
@@ -0,0 +1,154 @@
+#include "BayesFilters/ThreadPool.h"
+
+#include <algorithm>
+
+using namespace bfl;
+
+
+ThreadPool::ThreadPool(const unsigned int num_threads) :
+    next_block_(0)
+{
+    unsigned int num_workers = (num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 1u)) - 1;
+
+    for (unsigned int i = 0; i < num_workers; ++i)
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+
+ThreadPool::ThreadPool() :
+    ThreadPool(0) { }
+
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_job_);
+        teardown_ = true;
+    }
+    cv_job_.notify_all();
+
+    for (std::thread& worker : workers_)
+        if (worker.joinable())
+            worker.join();
+}
+
+
+void ThreadPool::parallelFor(const std::size_t size, const std::size_t block_size, const std::function<void(const std::size_t, const std::size_t)>& kernel)
+{
+    if (size == 0)
+        return;
+
+    const std::size_t block = std::max<std::size_t>(block_size, 1);
+
+    if (workers_.empty() || size <= block)
+    {
+        for (std::size_t begin = 0; begin < size; begin += block)
+            kernel(begin, std::min(begin + block, size));
+
+        return;
+    }
+
+    /* Only one range at a time is processed by the pool. */
+    std::lock_guard<std::mutex> lk_parallel_for(mtx_parallel_for_);
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_job_);
+        kernel_       = &kernel;
+        size_         = size;
+        block_size_   = block;
+        next_block_   = 0;
+        exception_    = nullptr;
+        busy_workers_ = static_cast<unsigned int>(workers_.size());
+        ++job_id_;
+    }
+    cv_job_.notify_all();
+
+    processBlocks();
+
+    std::unique_lock<std::mutex> lk(mtx_job_);
+    cv_done_.wait(lk, [this]{ return busy_workers_ == 0; });
+    kernel_ = nullptr;
+
+    if (exception_)
+        std::rethrow_exception(exception_);
+}
+
+
+unsigned int ThreadPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(workers_.size()) + 1;
+}
+
+
+void ThreadPool::forEachBlock(const std::shared_ptr<ThreadPool>& thread_pool, const std::size_t size, const std::size_t block_size,
+                              const std::function<void(const std::size_t, const std::size_t)>& kernel)
+{
+    if (thread_pool)
+        thread_pool->parallelFor(size, block_size, kernel);
+    else
+    {
+        const std::size_t block = std::max<std::size_t>(block_size, 1);
+
+        for (std::size_t begin = 0; begin < size; begin += block)
+            kernel(begin, std::min(begin + block, size));
+    }
+}
+
+
+std::size_t ThreadPool::getBlockSize(const std::size_t rows)
+{
+    /* Input and output blocks of floats sharing 128 KiB of cache. */
+    const std::size_t cache_bytes = 128 * 1024;
+
+    return std::max<std::size_t>(cache_bytes / (2 * sizeof(float) * std::max<std::size_t>(rows, 1)), 64);
+}
+
+
+void ThreadPool::workerLoop()
+{
+    unsigned long last_job_id = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lk(mtx_job_);
+            cv_job_.wait(lk, [this, last_job_id]{ return teardown_ || job_id_ != last_job_id; });
+
+            if (teardown_)
+                return;
+
+            last_job_id = job_id_;
+        }
+
+        processBlocks();
+
+        {
+            std::lock_guard<std::mutex> lk(mtx_job_);
+            --busy_workers_;
+        }
+        cv_done_.notify_one();
+    }
+}
+
+
+void ThreadPool::processBlocks()
+{
+    const std::size_t num_blocks = (size_ + block_size_ - 1) / block_size_;
+
+    for (std::size_t b = next_block_++; b < num_blocks; b = next_block_++)
+    {
+        const std::size_t begin = b * block_size_;
+        const std::size_t end   = std::min(begin + block_size_, size_);
+
+        try
+        {
+            (*kernel_)(begin, end);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lk(mtx_job_);
+            if (!exception_)
+                exception_ = std::current_exception();
+        }
+    }
+}
@@ -1,18 +1,283 @@
 #include "BayesFilters/UnscentedKalmanFilter.h"
 
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
 using namespace bfl;
+using namespace Eigen;
+
 
+UnscentedKalmanFilter::UnscentedKalmanFilter() noexcept { }
 
-UnscentedKalmanFilter::UnscentedKalmanFilter() { }
+
+UnscentedKalmanFilter::UnscentedKalmanFilter(UnscentedKalmanFilter&& ukf) noexcept :
+    simulation_time_(ukf.simulation_time_),
+    measurement_driven_(ukf.measurement_driven_),
+    state_model_(std::move(ukf.state_model_)),
+    observation_model_(std::move(ukf.observation_model_)),
+    sigma_point_transform_(std::move(ukf.sigma_point_transform_)),
+    Q_(std::move(ukf.Q_)),
+    R_(std::move(ukf.R_)),
+    x_0_(std::move(ukf.x_0_)),
+    P_0_(std::move(ukf.P_0_)),
+    object_(std::move(ukf.object_)),
+    measurement_(std::move(ukf.measurement_)),
+    x_(std::move(ukf.x_)),
+    P_(std::move(ukf.P_)),
+    result_x_(std::move(ukf.result_x_)),
+    result_P_(std::move(ukf.result_P_)),
+    skip_prediction_(ukf.skip_prediction_),
+    skip_correction_(ukf.skip_correction_),
+    x_pred_(std::move(ukf.x_pred_)),
+    P_pred_(std::move(ukf.P_pred_)),
+    z_pred_(std::move(ukf.z_pred_)),
+    S_(std::move(ukf.S_)),
+    S_llt_(std::move(ukf.S_llt_)),
+    C_(std::move(ukf.C_)),
+    Kt_(std::move(ukf.Kt_)),
+    y_(std::move(ukf.y_)),
+    KS_(std::move(ukf.KS_)) { }
 
 
 UnscentedKalmanFilter::~UnscentedKalmanFilter() noexcept { }
 
 
-void UnscentedKalmanFilter::initialization() { }
+UnscentedKalmanFilter& UnscentedKalmanFilter::operator=(UnscentedKalmanFilter&& ukf) noexcept
+{
+    simulation_time_    = ukf.simulation_time_;
+    measurement_driven_ = ukf.measurement_driven_;
+
+    state_model_           = std::move(ukf.state_model_);
+    observation_model_     = std::move(ukf.observation_model_);
+    sigma_point_transform_ = std::move(ukf.sigma_point_transform_);
+
+    Q_ = std::move(ukf.Q_);
+    R_ = std::move(ukf.R_);
+
+    x_0_ = std::move(ukf.x_0_);
+    P_0_ = std::move(ukf.P_0_);
+
+    object_      = std::move(ukf.object_);
+    measurement_ = std::move(ukf.measurement_);
+    x_           = std::move(ukf.x_);
+    P_           = std::move(ukf.P_);
+    result_x_    = std::move(ukf.result_x_);
+    result_P_    = std::move(ukf.result_P_);
+
+    skip_prediction_ = ukf.skip_prediction_;
+    skip_correction_ = ukf.skip_correction_;
+
+    x_pred_ = std::move(ukf.x_pred_);
+    P_pred_ = std::move(ukf.P_pred_);
+    z_pred_ = std::move(ukf.z_pred_);
+    S_      = std::move(ukf.S_);
+    S_llt_  = std::move(ukf.S_llt_);
+    C_      = std::move(ukf.C_);
+    Kt_     = std::move(ukf.Kt_);
+    y_      = std::move(ukf.y_);
+    KS_     = std::move(ukf.KS_);
+
+    return *this;
+}
+
+
+void UnscentedKalmanFilter::setStateModel(std::unique_ptr<StateModel> state_model)
+{
+    state_model_ = std::move(state_model);
+}
+
+
+void UnscentedKalmanFilter::setObservationModel(std::unique_ptr<ObservationModel> observation_model)
+{
+    observation_model_ = std::move(observation_model);
+}
+
+
+void UnscentedKalmanFilter::setSigmaPointTransform(std::unique_ptr<SigmaPointTransform> sigma_point_transform)
+{
+    sigma_point_transform_ = std::move(sigma_point_transform);
+}
+
+
+void UnscentedKalmanFilter::setInitialState(const Ref<const VectorXf>& mean, const Ref<const MatrixXf>& covariance)
+{
+    x_0_ = mean;
+    P_0_ = covariance;
+}
+
+
+bool UnscentedKalmanFilter::skip(const std::string& what_step, const bool status)
+{
+    if (what_step == "prediction")
+        skip_prediction_ = status;
+    else if (what_step == "correction")
+        skip_correction_ = status;
+    else if (what_step == "all")
+    {
+        skip_prediction_ = status;
+        skip_correction_ = status;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+
+void UnscentedKalmanFilter::initialization()
+{
+    Q_ = state_model_->getNoiseCovarianceMatrix();
+    R_ = observation_model_->getNoiseCovarianceMatrix();
+
+    const int state_size       = Q_.rows();
+    const int measurement_size = R_.rows();
+
+    /* GENERATE MEASUREMENTS */
+    if (measurement_driven_)
+    {
+        /* step(measurement) writes each measurement in the only column. */
+        object_.resize(state_size, 0);
+        measurement_.setZero(measurement_size, 1);
+    }
+    else
+    {
+        object_.resize(state_size, simulation_time_);
+        measurement_.resize(measurement_size, simulation_time_);
+
+        object_.col(0).setZero();
+        observation_model_->measure(object_.col(0), measurement_.col(0));
+        for (unsigned int k = 1; k < simulation_time_; ++k)
+        {
+            state_model_->motion(object_.col(k - 1), object_.col(k));
+            observation_model_->measure(object_.col(k), measurement_.col(k));
+        }
+    }
+
+    /* INITIALIZE FILTER */
+    if (!sigma_point_transform_)
+        sigma_point_transform_ = std::unique_ptr<SigmaPointTransform>(new SigmaPointTransform(state_size, SigmaPointTransform::Type::unscented));
+
+    if (x_0_.size() == state_size)
+        x_ = x_0_;
+    else
+        x_ = VectorXf::Zero(state_size);
+
+    if (P_0_.rows() == state_size)
+        P_ = P_0_;
+    else
+    {
+        P_.resize(state_size, state_size);
+        P_.setIdentity();
+        P_ *= 1000.0;
+    }
+
+    const unsigned int num_results = measurement_driven_ ? 0 : simulation_time_;
+    result_x_.resize(state_size, num_results);
+    result_P_.resize(state_size * state_size, num_results);
+
+    /* ALLOCATE WORKSPACES */
+    x_pred_.resize(state_size);
+    P_pred_.resize(state_size, state_size);
+    z_pred_.resize(measurement_size);
+    S_.resize(measurement_size, measurement_size);
+    S_llt_ = LLT<MatrixXf>(measurement_size);
+    C_.resize(state_size, measurement_size);
+    Kt_.resize(measurement_size, state_size);
+    y_.resize(measurement_size);
+    KS_.resize(state_size, measurement_size);
+}
+
+
+void UnscentedKalmanFilter::filteringStep()
+{
+    const unsigned int k = getFilteringStep();
+
+    if (k != 0 && !skip_prediction_)
+        predict();
+
+    if (!skip_correction_)
+        correct(measurement_.col(measurement_driven_ ? 0 : k));
+
+    if (!measurement_driven_)
+    {
+        result_x_.col(k) = x_;
+        result_P_.col(k) = Map<const VectorXf>(P_.data(), P_.size());
+    }
+}
+
+
+const VectorXf& UnscentedKalmanFilter::step(const Ref<const VectorXf>& measurement)
+{
+    if (!measurement_driven_)
+    {
+        measurement_driven_ = true;
+        reset();
+    }
+
+    if (!prepareStep())
+        throw std::runtime_error("ERROR::UNSCENTEDKALMANFILTER::STEP\nERROR:\n\tThe filter cannot run further steps.");
+
+    if (measurement.size() != measurement_.rows())
+        throw std::runtime_error("ERROR::UNSCENTEDKALMANFILTER::STEP\nERROR:\n\tMeasurement size does not match the observation model.");
+
+    measurement_.col(0) = measurement;
+
+    FilteringAlgorithm::step();
+
+    return x_;
+}
+
+
+void UnscentedKalmanFilter::getResult()
+{
+    std::ofstream result_file_object;
+    std::ofstream result_file_measurement;
+    std::ofstream result_file_state;
+    std::ofstream result_file_covariance;
+
+    result_file_object.open     ("./result_ukf_object.txt");
+    result_file_measurement.open("./result_ukf_measurement.txt");
+    result_file_state.open      ("./result_ukf_state.txt");
+    result_file_covariance.open ("./result_ukf_covariance.txt");
+
+    result_file_object      << object_;
+    result_file_measurement << measurement_;
+    result_file_state       << result_x_.leftCols(measurement_driven_ ? 0 : getFilteringStep());
+    result_file_covariance  << result_P_.leftCols(measurement_driven_ ? 0 : getFilteringStep());
+
+    result_file_object.close();
+    result_file_measurement.close();
+    result_file_state.close();
+    result_file_covariance.close();
+}
+
+
+void UnscentedKalmanFilter::predict()
+{
+    /* x, P = E[f(x)], Cov[f(x)] + Q */
+    sigma_point_transform_->propagate(*state_model_, x_, P_, x_pred_, P_pred_);
+    x_.swap(x_pred_);
+    P_.swap(P_pred_);
+    P_ += Q_;
+}
+
 
+void UnscentedKalmanFilter::correct(const Ref<const VectorXf>& measurement)
+{
+    /* Predicted measurement, its covariance S = Cov[h(x)] + R and the cross covariance C */
+    sigma_point_transform_->observe(*observation_model_, x_, P_, z_pred_, S_, C_);
+    S_ += R_;
 
-void UnscentedKalmanFilter::filteringStep() { }
+    /* Gain K = C S^-1, computed as the solution of S K' = C' */
+    S_llt_.compute(S_);
+    Kt_ = C_.transpose();
+    S_llt_.solveInPlace(Kt_);
 
+    y_ = measurement - z_pred_;
+    x_.noalias() += Kt_.transpose() * y_;
 
-void UnscentedKalmanFilter::getResult() { }
+    /* P = P - K S K' */
+    KS_.noalias() = Kt_.transpose() * S_;
+    P_.noalias() -= KS_ * Kt_;
+}
@@ -20,11 +20,31 @@ UpdateParticles::~UpdateParticles() noexcept { }
 void UpdateParticles::correctStep(const Ref<const MatrixXf>& pred_states, const Ref<const VectorXf>& pred_weights, const Ref<const MatrixXf>& measurements,
                                   Ref<MatrixXf> cor_states, Ref<VectorXf> cor_weights)
 {
-    MatrixXf innovations(measurements.rows(), pred_states.cols());
-    innovation(pred_states, measurements, innovations);
-
-    for (unsigned int i = 0; i < innovations.cols(); ++i)
-        cor_weights(i) = likelihood(innovations.col(i));
+    innovations_.resize(measurements.rows(), pred_states.cols());
+
+    if (thread_pool_)
+    {
+        thread_pool_->parallelFor(pred_states.cols(), ThreadPool::getBlockSize(pred_states.rows()),
+                                  [&](const std::size_t begin, const std::size_t end)
+                                  {
+                                      innovation(pred_states.middleCols(begin, end - begin), measurements, innovations_.middleCols(begin, end - begin));
+                                  });
+    }
+    else
+        innovation(pred_states, measurements, innovations_);
+
+    if (getLogWeights())
+    {
+        logLikelihoods(innovations_, cor_weights);
+
+        cor_weights += pred_weights;
+    }
+    else
+    {
+        likelihoods(innovations_, cor_weights);
+
+        cor_weights = cor_weights.cwiseProduct(pred_weights);
+    }
 
     cor_states = pred_states;
 }
@@ -32,16 +52,62 @@ void UpdateParticles::correctStep(const Ref<const MatrixXf>& pred_states, const
 
 void UpdateParticles::innovation(const Ref<const MatrixXf>& pred_states, const Ref<const MatrixXf>& measurements, Ref<MatrixXf> innovations)
 {
-    MatrixXf virtual_measurements(measurements.rows(), pred_states.cols());
-    observation_model_->observe(pred_states, virtual_measurements);
+    observation_model_->observe(pred_states, innovations);
 
-    innovations = virtual_measurements.colwise() - measurements.col(0);
+    innovations.colwise() -= measurements.col(0);
 }
 
 
 double UpdateParticles::likelihood(const Ref<const VectorXf>& innovation)
 {
-    return (- 0.5 * static_cast<float>(innovation.rows()) * log(2.0*M_PI) - 0.5 * log(observation_model_->getNoiseCovarianceMatrix().determinant()) - 0.5 * (innovation.transpose() * observation_model_->getNoiseCovarianceMatrix().inverse() * innovation).array()).exp().cast<double>().coeff(0);
+    float log_norm_factor = factorizeNoiseCovariance();
+
+    VectorXf whitened_innovation = noise_covariance_llt_.matrixL().solve(innovation);
+
+    return std::exp(static_cast<double>(log_norm_factor - 0.5f * whitened_innovation.squaredNorm()));
+}
+
+
+void UpdateParticles::likelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_weights)
+{
+    logLikelihoods(innovations, cor_weights);
+
+    cor_weights = cor_weights.array().exp();
+}
+
+
+void UpdateParticles::logLikelihoods(const Ref<const MatrixXf>& innovations, Ref<VectorXf> cor_log_weights)
+{
+    float log_norm_factor = factorizeNoiseCovariance();
+
+    whitened_innovations_.resize(innovations.rows(), innovations.cols());
+
+    /* Mahalanobis distances of a block of innovations: || L^-1 * innovations ||^2, column-wise. */
+    auto log_likelihood_kernel = [&](const std::size_t begin, const std::size_t end)
+    {
+        Block<MatrixXf, Dynamic, Dynamic, true> whitened = whitened_innovations_.middleCols(begin, end - begin);
+
+        whitened = innovations.middleCols(begin, end - begin);
+        noise_covariance_llt_.matrixL().solveInPlace(whitened);
+
+        cor_log_weights.segment(begin, end - begin) = (log_norm_factor - 0.5f * whitened.colwise().squaredNorm().array()).transpose();
+    };
+
+    if (thread_pool_)
+        thread_pool_->parallelFor(innovations.cols(), ThreadPool::getBlockSize(innovations.rows()), log_likelihood_kernel);
+    else
+        log_likelihood_kernel(0, innovations.cols());
+}
+
+
+float UpdateParticles::factorizeNoiseCovariance()
+{
+    noise_covariance_llt_.compute(observation_model_->getNoiseCovarianceMatrix());
+
+    const MatrixXf& L = noise_covariance_llt_.matrixLLT();
+
+    /* log(det(R))/2 = sum(log(diag(L))) */
+    return - 0.5f * static_cast<float>(L.rows()) * std::log(2.0f * static_cast<float>(M_PI)) - L.diagonal().array().log().sum();
 }
 
 
@@ -1,5 +1,6 @@
 #include "BayesFilters/WhiteNoiseAcceleration.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -11,7 +12,7 @@ using namespace Eigen;
 
 WhiteNoiseAcceleration::WhiteNoiseAcceleration(float T, float tilde_q, unsigned int seed) noexcept :
     T_(T), tilde_q_(tilde_q),
-    generator_(std::mt19937_64(seed)), distribution_(std::normal_distribution<float>(0.0, 1.0)), gauss_rnd_sample_([&] { return (distribution_)(generator_); })
+    gaussian_sampler_(seed)
 {
     F_ << 1.0,  T_, 0.0, 0.0,
           0.0, 1.0, 0.0, 0.0,
@@ -44,12 +45,12 @@ WhiteNoiseAcceleration::~WhiteNoiseAcceleration() noexcept { }
 
 WhiteNoiseAcceleration::WhiteNoiseAcceleration(const WhiteNoiseAcceleration& wna) :
     T_(wna.T_), F_(wna.F_), Q_(wna.Q_), tilde_q_(wna.tilde_q_),
-    sqrt_Q_(wna.sqrt_Q_), generator_(wna.generator_), distribution_(wna.distribution_), gauss_rnd_sample_(wna.gauss_rnd_sample_) { }
+    sqrt_Q_(wna.sqrt_Q_), gaussian_sampler_(wna.gaussian_sampler_) { }
 
 
 WhiteNoiseAcceleration::WhiteNoiseAcceleration(WhiteNoiseAcceleration&& wna) noexcept :
     T_(wna.T_), F_(std::move(wna.F_)), Q_(std::move(wna.Q_)), tilde_q_(wna.tilde_q_),
-    sqrt_Q_(std::move(wna.sqrt_Q_)), generator_(std::move(wna.generator_)), distribution_(std::move(wna.distribution_)), gauss_rnd_sample_(std::move(wna.gauss_rnd_sample_))
+    sqrt_Q_(std::move(wna.sqrt_Q_)), gaussian_sampler_(std::move(wna.gaussian_sampler_))
 {
     wna.T_       = 0.0;
     wna.tilde_q_ = 0.0;
@@ -73,9 +74,7 @@ WhiteNoiseAcceleration& WhiteNoiseAcceleration::operator=(WhiteNoiseAcceleration
     tilde_q_ = wna.tilde_q_;
 
     sqrt_Q_           = std::move(wna.sqrt_Q_);
-    generator_        = std::move(wna.generator_);
-    distribution_     = std::move(wna.distribution_);
-    gauss_rnd_sample_ = std::move(wna.gauss_rnd_sample_);
+    gaussian_sampler_ = std::move(wna.gaussian_sampler_);
 
     wna.T_       = 0.0;
     wna.tilde_q_ = 0.0;
@@ -92,22 +91,54 @@ void WhiteNoiseAcceleration::propagate(const Ref<const MatrixXf>& cur_states, Re
 
 void WhiteNoiseAcceleration::motion(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf> prop_states)
 {
-    propagate(cur_states, prop_states);
+    std::lock_guard<std::mutex> lk(mtx_noise_);
 
-    prop_states += getNoiseSample(prop_states.cols());
+    motionBlocks(cur_states, prop_states, false, 0, 0);
+}
+
+
+void WhiteNoiseAcceleration::keyedMotion(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf> prop_states,
+                                         const std::uint64_t step, const std::uint64_t first_state)
+{
+    motionBlocks(cur_states, prop_states, true, step, first_state);
 }
 
 
 MatrixXf WhiteNoiseAcceleration::getNoiseSample(const int num)
 {
     MatrixXf rand_vectors(4, num);
-    for (int i = 0; i < rand_vectors.size(); i++)
-        *(rand_vectors.data() + i) = gauss_rnd_sample_();
+    {
+        std::lock_guard<std::mutex> lk(mtx_noise_);
+
+        gaussian_sampler_.fill(rand_vectors);
+    }
 
     return sqrt_Q_ * rand_vectors;
 }
 
 
+void WhiteNoiseAcceleration::motionBlocks(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf> prop_states,
+                                          const bool keyed, const std::uint64_t step, const std::uint64_t first_state)
+{
+    constexpr int block_size = 64;
+
+    Matrix<float, 4, block_size> rand_vectors;
+
+    for (int j = 0; j < prop_states.cols(); j += block_size)
+    {
+        const int num = std::min<int>(block_size, prop_states.cols() - j);
+
+        Map<MatrixXf> block_rand_vectors(rand_vectors.data(), 4, num);
+        if (keyed)
+            gaussian_sampler_.fill(block_rand_vectors, step, first_state + j);
+        else
+            gaussian_sampler_.fill(block_rand_vectors);
+
+        prop_states.middleCols(j, num) = F_ * cur_states.middleCols(j, num) + sqrt_Q_ * block_rand_vectors;
+    }
+}
+
+
 MatrixXf WhiteNoiseAcceleration::getNoiseCovarianceMatrix()
 {
     return Q_;
@@ -0,0 +1,113 @@
+#ifndef FILTERTESTUTILS_H
+#define FILTERTESTUTILS_H
+
+#include <cmath>
+
+#include <Eigen/Dense>
+
+
+/**
+ * Textbook Kalman filter in double precision, starting from state x_0 with
+ * covariance 1000 I, correcting with the first measurement at step 0 and
+ * predicting before every following correction. Return the corrected state
+ * means, one per column.
+ */
+inline Eigen::MatrixXd referenceKalmanFilter(const Eigen::Ref<const Eigen::MatrixXd>& F, const Eigen::Ref<const Eigen::MatrixXd>& H,
+                                             const Eigen::Ref<const Eigen::MatrixXd>& Q, const Eigen::Ref<const Eigen::MatrixXd>& R,
+                                             const Eigen::Ref<const Eigen::MatrixXd>& measurements, const Eigen::Ref<const Eigen::VectorXd>& x_0)
+{
+    const Eigen::MatrixXd I = Eigen::MatrixXd::Identity(F.rows(), F.cols());
+
+    Eigen::VectorXd x = x_0;
+    Eigen::MatrixXd P = 1000.0 * I;
+
+    Eigen::MatrixXd result(F.rows(), measurements.cols());
+    for (int k = 0; k < measurements.cols(); ++k)
+    {
+        if (k != 0)
+        {
+            x = F * x;
+            P = F * P * F.transpose() + Q;
+        }
+
+        const Eigen::MatrixXd K = P * H.transpose() * (H * P * H.transpose() + R).inverse();
+        x = x + K * (measurements.col(k) - H * x);
+        P = (I - K * H) * P;
+
+        result.col(k) = x;
+    }
+
+    return result;
+}
+
+
+/**
+ * Average absolute difference between estimates and truth over the second
+ * half of the run.
+ */
+inline double trackingError(const Eigen::Ref<const Eigen::RowVectorXf>& estimates, const Eigen::Ref<const Eigen::RowVectorXf>& truth)
+{
+    const int num_steps = estimates.size() / 2;
+
+    return (estimates - truth).tail(num_steps).cwiseAbs().mean();
+}
+
+
+/**
+ * Particle filter, SIS or derived from it, with num_particles particles, a
+ * square number, that stores the weighted mean of the normalized log-weights
+ * at every step.
+ */
+template<class Filter>
+class Estimates : public Filter
+{
+public:
+    Estimates(const int num_particles) :
+        num_particles_(num_particles) { }
+
+    /* Root mean square position error of the weighted mean over the second half of the run. */
+    double getError()
+    {
+        const Eigen::MatrixXf error = (estimates_ - this->object_).rightCols(this->simulation_time_ / 2);
+
+        return std::sqrt((error.row(0).squaredNorm() + error.row(2).squaredNorm()) / (this->simulation_time_ / 2));
+    }
+
+protected:
+    void initialization() override
+    {
+        Filter::initialization();
+
+        /* Start from num_particles particles, spread on the grid as by
+         * SIS::initialization(), so that the first step already uses them. */
+        const int particle_spread = std::sqrt(num_particles_);
+
+        this->num_particle_ = particle_spread * particle_spread;
+
+        this->pred_particle_.resize(4, this->num_particle_);
+        for (int i = 0; i < particle_spread; ++i)
+            for (int j = 0; j < particle_spread; ++j)
+                this->pred_particle_.col(i * particle_spread + j) << (this->surv_x_ / particle_spread) * i, 0, (this->surv_y_ / particle_spread) * j, 0;
+
+        this->pred_weight_.setConstant(this->num_particle_, -std::log(static_cast<float>(this->num_particle_)));
+
+        this->cor_particle_.resize(4, this->num_particle_);
+        this->cor_weight_.resize(this->num_particle_);
+
+        estimates_.resize(4, this->simulation_time_);
+    }
+
+    void filteringStep() override
+    {
+        Filter::filteringStep();
+
+        /* The weights are normalized log-weights. */
+        estimates_.col(this->getFilteringStep()) = this->cor_particle_ * this->cor_weight_.array().exp().matrix();
+    }
+
+    int             num_particles_;
+
+    Eigen::MatrixXf estimates_;
+};
+
+#endif /* FILTERTESTUTILS_H */
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/APF.h>
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/UpdateParticles.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include "FilterTestUtils.h"
+
+using namespace bfl;
+using namespace Eigen;
+
+
+template<class Filter>
+double run_filter(const int num_particles)
+{
+    std::unique_ptr<DrawParticles> pf_prediction(new DrawParticles());
+    pf_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+
+    std::unique_ptr<UpdateParticles> pf_correction(new UpdateParticles());
+    pf_correction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor(1.0f, 1.0f)));
+
+    Estimates<Filter> pf(num_particles);
+    pf.setPrediction(std::move(pf_prediction));
+    pf.setCorrection(std::move(pf_correction));
+    pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    pf.setLogWeights(true);
+
+    pf.boot();
+    pf.run();
+    pf.wait();
+
+    return pf.getError();
+}
+
+
+int main()
+{
+    std::cout << "Running SIS particle filter with 900 particles..." << std::flush;
+    const double sis_error = run_filter<SIS>(900);
+    std::cout << "position error " << sis_error << std::endl;
+
+
+    std::cout << "Running SIS particle filter with 100 particles..." << std::flush;
+    const double sis_small_error = run_filter<SIS>(100);
+    std::cout << "position error " << sis_small_error << std::endl;
+
+
+    std::cout << "Running auxiliary particle filter with 100 particles..." << std::flush;
+    const double apf_error = run_filter<APF>(100);
+    std::cout << "position error " << apf_error << std::endl;
+
+    if (!(apf_error < sis_small_error && apf_error <= 1.1 * sis_error))
+        return EXIT_FAILURE;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <limits>
+#include <memory>
+
+#include <BayesFilters/BatchKalmanFilter.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+int main()
+{
+    const int num_tracks = 1000;
+
+    MatrixXf F(4, 4);
+    F << 1.0, 1.0, 0.0, 0.0,
+         0.0, 1.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 1.0,
+         0.0, 0.0, 0.0, 1.0;
+
+    MatrixXf H(2, 4);
+    H << 1.0, 0.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 0.0;
+
+    BatchKalmanFilter batch_kf(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F,
+                               std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+
+    const MatrixXd Q = batch_kf.getStateModel().getNoiseCovarianceMatrix().cast<double>();
+    const MatrixXd R = batch_kf.getObservationModel().getNoiseCovarianceMatrix().cast<double>();
+
+
+    MatrixXf means = 100.0f * MatrixXf::Random(4, num_tracks);
+    MatrixXf covariances(16, num_tracks);
+    for (int t = 0; t < num_tracks; ++t)
+    {
+        const Matrix4f A = Matrix4f::Random();
+        const Matrix4f P = A * A.transpose() + Matrix4f::Identity();
+        covariances.col(t) = Map<const VectorXf>(P.data(), 16);
+    }
+
+    const MatrixXf measurements = 100.0f * MatrixXf::Random(2, num_tracks);
+
+    Array<bool, Dynamic, 1> mask(num_tracks);
+    for (int t = 0; t < num_tracks; ++t)
+        mask(t) = (t % 3) != 0;
+
+
+    std::cout << "Running batched predict and masked update..." << std::flush;
+    batch_kf.initialize(means, covariances);
+    batch_kf.predict();
+    batch_kf.correct(measurements, mask);
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Comparing with a textbook Kalman filter on each track..." << std::flush;
+    double max_error = 0.0;
+    for (int t = 0; t < num_tracks; ++t)
+    {
+        VectorXd x = means.col(t).cast<double>();
+        MatrixXd P = Map<const MatrixXf>(covariances.col(t).data(), 4, 4).cast<double>();
+
+        x = F.cast<double>() * x;
+        P = F.cast<double>() * P * F.cast<double>().transpose() + Q;
+
+        if (mask(t))
+        {
+            const MatrixXd K = P * H.cast<double>().transpose() * (H.cast<double>() * P * H.cast<double>().transpose() + R).inverse();
+            x = x + K * (measurements.col(t).cast<double>() - H.cast<double>() * x);
+            P = (MatrixXd::Identity(4, 4) - K * H.cast<double>()) * P;
+        }
+
+        max_error = std::max(max_error, (batch_kf.getMean(t).cast<double>() - x).cwiseAbs().maxCoeff() / (1.0 + x.cwiseAbs().maxCoeff()));
+        max_error = std::max(max_error, (batch_kf.getCovariance(t).cast<double>() - P).cwiseAbs().maxCoeff() / (1.0 + P.cwiseAbs().maxCoeff()));
+    }
+    std::cout << "maximum relative error " << max_error << std::endl;
+
+    if (max_error > 1e-4)
+        return EXIT_FAILURE;
+
+
+    std::cout << "Running masked update with NaN measurements on the masked tracks..." << std::flush;
+    MatrixXf nan_measurements = measurements;
+    for (int t = 0; t < num_tracks; ++t)
+        if (!mask(t))
+            nan_measurements.col(t).setConstant(std::numeric_limits<float>::quiet_NaN());
+
+    BatchKalmanFilter nan_batch_kf(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F,
+                                   std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+    nan_batch_kf.initialize(means, covariances);
+    nan_batch_kf.predict();
+    nan_batch_kf.correct(nan_measurements, mask);
+
+    for (int t = 0; t < num_tracks; ++t)
+    {
+        if (nan_batch_kf.getMean(t) != batch_kf.getMean(t) || nan_batch_kf.getCovariance(t) != batch_kf.getCovariance(t))
+        {
+            std::cerr << "failed, track " << t << " differs from the update without NaN measurements!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+
+#include <BayesFilters/EstimatesExtraction.h>
+#include <BayesFilters/StateLayout.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class TestEstimatesExtraction : public EstimatesExtraction
+{
+public:
+    VectorXf weightedMean(const Ref<const MatrixXf>& particles, const Ref<const VectorXf>& weights) const
+    {
+        return mean(particles, weights);
+    }
+};
+
+
+/* Moving averages recomputed from the whole window at every step, as in the previous implementation. */
+bool check_moving_average(const EstimatesExtraction::ExtractionMethod method)
+{
+    TestEstimatesExtraction estimates_extraction;
+    estimates_extraction.setMethod(method);
+
+    TestEstimatesExtraction reference_extraction;
+
+    std::deque<VectorXf> history;
+    unsigned int window = 5;
+
+    for (int k = 0; k < 200; ++k)
+    {
+        if (k == 100)
+        {
+            window = 3;
+            estimates_extraction.setMobileAverageWindowSize(window);
+        }
+
+        MatrixXf particles = MatrixXf::Random(7, 50);
+        particles.middleRows<3>(3).colwise() += Vector3f(0.0f, 0.0f, 5.0f);
+        particles.middleRows<3>(3).colwise().normalize();
+        particles.row(6) *= static_cast<float>(M_PI);
+
+        const VectorXf weights = VectorXf::Ones(50) / 50.0f;
+
+        const VectorXf estimate = estimates_extraction.extract(particles, weights);
+
+        history.push_front(reference_extraction.weightedMean(particles, weights));
+        while (history.size() > window)
+            history.pop_back();
+
+        MatrixXf history_matrix(7, history.size());
+        VectorXf history_weights(history.size());
+        for (unsigned int i = 0; i < history.size(); ++i)
+        {
+            history_matrix.col(i) = history[i];
+
+            if (method == EstimatesExtraction::ExtractionMethod::smean)
+                history_weights(i) = 1.0f;
+            else if (method == EstimatesExtraction::ExtractionMethod::wmean)
+                history_weights(i) = history.size() - i;
+            else
+                history_weights(i) = std::exp(-(static_cast<double>(i) / history.size()));
+        }
+        history_weights /= history_weights.sum();
+
+        const float error = (estimate - reference_extraction.weightedMean(history_matrix, history_weights)).cwiseAbs().maxCoeff();
+        if (error > 1e-4)
+        {
+            std::cerr << "failed at step " << k << ", error " << error << "!" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    const int num_particles = 1000;
+
+    VectorXf weights = VectorXf::Random(num_particles).cwiseAbs();
+    weights /= weights.sum();
+
+
+    std::cout << "Checking the mean of a linear state..." << std::flush;
+    {
+        const MatrixXf particles = MatrixXf::Random(4, num_particles);
+
+        EstimatesExtraction estimates_extraction(StateLayout(4));
+        estimates_extraction.setMethod(EstimatesExtraction::ExtractionMethod::mean);
+
+        const float error = (estimates_extraction.extract(particles, weights) - particles * weights).cwiseAbs().maxCoeff();
+        if (error > 1e-5)
+        {
+            std::cerr << "failed, error " << error << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking the state layout size..." << std::flush;
+    {
+        /* Without a layout, states of other sizes than the default 7D are linear. */
+        const MatrixXf particles = MatrixXf::Random(4, num_particles);
+
+        EstimatesExtraction estimates_extraction;
+        estimates_extraction.setMethod(EstimatesExtraction::ExtractionMethod::mean);
+
+        const VectorXf estimate = estimates_extraction.extract(particles, weights);
+        if (estimate.size() != 4 || (estimate - particles * weights).cwiseAbs().maxCoeff() > 1e-5)
+        {
+            std::cerr << "failed, wrong default layout!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* An explicit layout must match the particles. */
+        EstimatesExtraction layout_extraction(StateLayout(3));
+        layout_extraction.setMethod(EstimatesExtraction::ExtractionMethod::mean);
+
+        bool thrown = false;
+        try
+        {
+            layout_extraction.extract(particles, weights);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        if (!thrown)
+        {
+            std::cerr << "failed, mismatching layout accepted!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking the mean of the default 7D layout..." << std::flush;
+    {
+        MatrixXf particles = MatrixXf::Random(7, num_particles);
+        particles.middleRows<3>(3).colwise() += Vector3f(0.0f, 0.0f, 10.0f);
+        particles.middleRows<3>(3).colwise().normalize();
+        particles.row(6) *= static_cast<float>(M_PI);
+
+        /* Previous per-particle implementation */
+        VectorXf reference = VectorXf::Zero(7);
+        float s_ang = 0;
+        float c_ang = 0;
+        for (int i = 0; i < num_particles; ++i)
+        {
+            reference.head<6>() += weights(i) * particles.col(i).head<6>();
+            s_ang += weights(i) * std::sin(particles(6, i));
+            c_ang += weights(i) * std::cos(particles(6, i));
+        }
+        reference.middleRows<3>(3).normalize();
+        reference(6) = std::atan2(s_ang, c_ang);
+
+        EstimatesExtraction estimates_extraction;
+        estimates_extraction.setMethod(EstimatesExtraction::ExtractionMethod::mean);
+
+        const float error = (estimates_extraction.extract(particles, weights) - reference).cwiseAbs().maxCoeff();
+        if (error > 1e-4)
+        {
+            std::cerr << "failed, error " << error << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking the mean of angles and quaternions..." << std::flush;
+    {
+        /* Angles scattered around pi and quaternions around a fixed rotation with random signs */
+        const Vector4f rotation = Vector4f(1.0f, 2.0f, 3.0f, 4.0f).normalized();
+
+        MatrixXf particles(5, num_particles);
+        for (int i = 0; i < num_particles; ++i)
+        {
+            const float angle = static_cast<float>(M_PI) + 0.1f * (i % 2 == 0 ? 1.0f : -1.0f);
+            particles(0, i) = std::atan2(std::sin(angle), std::cos(angle));
+
+            const Vector4f quaternion = (rotation + 0.01f * Vector4f::Random()).normalized();
+            particles.bottomRows<4>().col(i) = (i % 3 == 0 ? -1.0f : 1.0f) * quaternion;
+        }
+
+        StateLayout state_layout;
+        state_layout.addBlock(StateLayout::BlockType::angle,      1);
+        state_layout.addBlock(StateLayout::BlockType::quaternion, 4);
+
+        EstimatesExtraction estimates_extraction(state_layout);
+        estimates_extraction.setMethod(EstimatesExtraction::ExtractionMethod::mean);
+
+        const VectorXf estimate = estimates_extraction.extract(particles, VectorXf::Ones(num_particles) / num_particles);
+
+        const float angle_error      = std::abs(std::abs(estimate(0)) - static_cast<float>(M_PI));
+        const float quaternion_error = 1.0f - std::abs(estimate.tail<4>().dot(rotation));
+        if (angle_error > 1e-3 || quaternion_error > 1e-3)
+        {
+            std::cerr << "failed, angle error " << angle_error << ", quaternion error " << quaternion_error << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking moving averages of a linear state..." << std::flush;
+    {
+        EstimatesExtraction estimates_extraction(StateLayout(4));
+        estimates_extraction.setMethod(EstimatesExtraction::ExtractionMethod::smean);
+        estimates_extraction.setMobileAverageWindowSize(2);
+
+        estimates_extraction.extract(MatrixXf::Zero(4, 1), VectorXf::Ones(1));
+        estimates_extraction.extract(MatrixXf::Ones(4, 1), VectorXf::Ones(1));
+        const VectorXf estimate = estimates_extraction.extract(3.0 * MatrixXf::Ones(4, 1), VectorXf::Ones(1));
+
+        if (estimate.size() != 4 || (estimate.array() - 2.0f).abs().maxCoeff() > 1e-6)
+        {
+            std::cerr << "failed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking incremental moving averages against the whole window..." << std::flush;
+    if (!check_moving_average(EstimatesExtraction::ExtractionMethod::smean) ||
+        !check_moving_average(EstimatesExtraction::ExtractionMethod::wmean) ||
+        !check_moving_average(EstimatesExtraction::ExtractionMethod::emean))
+        return EXIT_FAILURE;
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
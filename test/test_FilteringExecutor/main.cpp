@@ -0,0 +1,195 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <BayesFilters/FilteringExecutor.h>
+#include <BayesFilters/KalmanFilter.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class TestKalmanFilter : public KalmanFilter
+{
+public:
+    TestKalmanFilter(const unsigned int seed)
+    {
+        MatrixXf F(4, 4);
+        F << 1.0, 1.0, 0.0, 0.0,
+             0.0, 1.0, 0.0, 0.0,
+             0.0, 0.0, 1.0, 1.0,
+             0.0, 0.0, 0.0, 1.0;
+
+        MatrixXf H(2, 4);
+        H << 1.0, 0.0, 0.0, 0.0,
+             0.0, 0.0, 1.0, 0.0;
+
+        setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration(1.0f, 10.0f, seed)), F);
+        setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor(10.0f, 10.0f, seed + 1)), H);
+    }
+
+    MatrixXf getStates() { return result_x_; }
+};
+
+
+/* A filter running until teardown, counting its initializations. */
+class EndlessFilter : public FilteringAlgorithm
+{
+public:
+    bool skip(const std::string& /* what_step */, const bool /* status */) override { return false; }
+
+    std::atomic<unsigned int> num_initializations{0};
+
+protected:
+    void initialization() override { ++num_initializations; }
+
+    void filteringStep() override { }
+
+    void getResult() override { }
+
+    bool runCondition() override { return true; }
+};
+
+
+bool wait_for(const std::function<bool()>& condition)
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (condition())
+            return true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+
+
+int main()
+{
+    const unsigned int num_filters = 200;
+
+    std::shared_ptr<FilteringExecutor> executor = std::make_shared<FilteringExecutor>(4);
+
+
+    std::cout << "Running " << num_filters << " Kalman filters on " << executor->getNumThreads() << " threads..." << std::flush;
+    std::vector<std::unique_ptr<TestKalmanFilter>> filters;
+    for (unsigned int i = 0; i < num_filters; ++i)
+    {
+        filters.emplace_back(new TestKalmanFilter(2 * i + 1));
+        if (!filters.back()->boot(executor))
+            return EXIT_FAILURE;
+    }
+
+    for (auto& filter : filters)
+        filter->run();
+
+    for (auto& filter : filters)
+    {
+        if (!filter->wait())
+            return EXIT_FAILURE;
+    }
+    std::cout << "completed!" << std::endl;
+
+
+    std::cout << "Checking results against filters on dedicated threads..." << std::flush;
+    for (unsigned int i = 0; i < num_filters; i += 20)
+    {
+        TestKalmanFilter reference(2 * i + 1);
+        reference.boot();
+        reference.run();
+        reference.wait();
+
+        if (filters[i]->getFilteringStep() != reference.getFilteringStep() || filters[i]->getStates() != reference.getStates())
+        {
+            std::cerr << "failed, filter " << i << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking reboot and teardown..." << std::flush;
+    {
+        EndlessFilter filter;
+        filter.boot(executor);
+        filter.run();
+
+        if (!wait_for([&filter]{ return filter.getFilteringStep() > 100; }))
+        {
+            std::cerr << "failed, filter not running!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* After a reboot the filter waits for run() and initializes again. */
+        filter.reboot();
+        filter.run();
+
+        if (!wait_for([&filter]{ return filter.num_initializations >= 2 && filter.getFilteringStep() > 100; }))
+        {
+            std::cerr << "failed, filter not rebooted!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        filter.teardown();
+        if (!filter.wait() || filter.isRunning())
+        {
+            std::cerr << "failed, filter not closed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    {
+        /* A filter that never ran closes on teardown. */
+        EndlessFilter filter;
+        filter.boot(executor);
+        filter.teardown();
+
+        if (!filter.wait() || filter.getFilteringStep() != 0)
+        {
+            std::cerr << "failed, idle filter not closed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Destroying a filter whose task is still queued..." << std::flush;
+    {
+        std::shared_ptr<FilteringExecutor> single_executor = std::make_shared<FilteringExecutor>(1);
+
+        /* Keep the only worker busy, so that the task of the filter stays queued. */
+        std::atomic<bool> release(false);
+        single_executor->submit([&release]{ while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+
+        std::thread releaser([&release]
+                             {
+                                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                                 release = true;
+                             });
+
+        {
+            EndlessFilter filter;
+            filter.boot(single_executor);
+            filter.run();
+        }
+
+        releaser.join();
+
+        std::atomic<bool> done(false);
+        single_executor->submit([&done]{ done = true; });
+        if (!wait_for([&done]{ return done.load(); }))
+        {
+            std::cerr << "failed, executor stalled!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/FixedDrawParticles.h>
+#include <BayesFilters/FixedObservationModel.h>
+#include <BayesFilters/FixedSIS.h>
+#include <BayesFilters/FixedStateModel.h>
+#include <BayesFilters/FixedUpdateParticles.h>
+#include <BayesFilters/GaussianSampler.h>
+#include <BayesFilters/Resampling.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/* Constant velocity model on the plane, state (x, v_x, y, v_y). */
+class FixedWhiteNoiseAcceleration : public FixedStateModel<4>
+{
+public:
+    FixedWhiteNoiseAcceleration()
+    {
+        F_ << 1.0, 1.0, 0.0, 0.0,
+              0.0, 1.0, 0.0, 0.0,
+              0.0, 0.0, 1.0, 1.0,
+              0.0, 0.0, 0.0, 1.0;
+
+        Q_ << 1.0 / 3.0, 0.5, 0.0,       0.0,
+              0.5,       1.0, 0.0,       0.0,
+              0.0,       0.0, 1.0 / 3.0, 0.5,
+              0.0,       0.0, 0.5,       1.0;
+
+        sqrt_Q_ = Q_.llt().matrixL();
+    }
+
+    void propagate(const Ref<const StateMatrix>& cur_states, Ref<StateMatrix> prop_states) override
+    {
+        prop_states = F_ * cur_states;
+    }
+
+    void motion(const Ref<const StateMatrix>& cur_states, Ref<StateMatrix> mot_states) override
+    {
+        StateMatrix noise(4, cur_states.cols());
+        sampler_.fill(noise);
+
+        mot_states = F_ * cur_states + sqrt_Q_ * noise;
+    }
+
+    CovarianceMatrix getNoiseCovarianceMatrix() override
+    {
+        return Q_;
+    }
+
+private:
+    Matrix4f        F_;
+    Matrix4f        Q_;
+    Matrix4f        sqrt_Q_;
+    GaussianSampler sampler_;
+};
+
+
+class FixedLinearSensor : public FixedObservationModel<4, 2>
+{
+public:
+    void observe(const Ref<const StateMatrix>& cur_states, Ref<MeasurementMatrix> observations) override
+    {
+        observations.row(0) = cur_states.row(0);
+        observations.row(1) = cur_states.row(2);
+    }
+
+    void measure(const Ref<const StateMatrix>& cur_states, Ref<MeasurementMatrix> measurements) override
+    {
+        MeasurementMatrix noise(2, cur_states.cols());
+        sampler_.fill(noise);
+
+        observe(cur_states, measurements);
+        measurements += 10.0f * noise;
+    }
+
+    CovarianceMatrix getNoiseCovarianceMatrix() override
+    {
+        return 100.0f * Matrix2f::Identity();
+    }
+
+private:
+    GaussianSampler sampler_{2};
+};
+
+
+class TrackingSIS : public FixedSIS<4, 2>
+{
+public:
+    double getError() { return error_ / simulation_time_; }
+
+protected:
+    void initialization() override
+    {
+        object_.resize(4, simulation_time_);
+        object_.col(0) << 0, 10, 0, 10;
+        for (unsigned int k = 1; k < simulation_time_; ++k)
+            motion_.motion(object_.col(k - 1), object_.col(k));
+
+        pred_particle_.resize(4, 1000);
+        for (int i = 0; i < 1000; ++i)
+            pred_particle_.col(i) << (i % 40) * 25.0f - 500.0f, 10, (i / 40) * 40.0f - 500.0f, 10;
+
+        pred_weight_.setConstant(1000, 1.0f / 1000);
+        cor_particle_.resize(4, 1000);
+        cor_weight_.resize(1000);
+
+        error_ = 0.0;
+    }
+
+    void getMeasurement(Ref<MeasurementVector> measurement) override
+    {
+        sensor_.measure(object_.col(getFilteringStep()), measurement);
+    }
+
+    void filteringStep() override
+    {
+        FixedSIS<4, 2>::filteringStep();
+
+        const Vector4f estimate = cor_particle_ * cor_weight_ / cor_weight_.sum();
+        if (getFilteringStep() >= 10)
+            error_ += std::sqrt(std::pow(estimate(0) - object_(0, getFilteringStep()), 2.0f) +
+                                std::pow(estimate(2) - object_(2, getFilteringStep()), 2.0f));
+    }
+
+    void getResult() override { }
+
+    bool runCondition() override { return getFilteringStep() < simulation_time_; }
+
+private:
+    const unsigned int          simulation_time_ = 100;
+
+    Matrix<float, 4, Dynamic>   object_;
+
+    FixedWhiteNoiseAcceleration motion_;
+
+    FixedLinearSensor           sensor_;
+
+    double                      error_ = 0.0;
+};
+
+
+int main()
+{
+    std::unique_ptr<FixedDrawParticles<4>> pf_prediction(new FixedDrawParticles<4>());
+    pf_prediction->setStateModel(std::unique_ptr<FixedStateModel<4>>(new FixedWhiteNoiseAcceleration()));
+
+    std::unique_ptr<FixedUpdateParticles<4, 2>> pf_correction(new FixedUpdateParticles<4, 2>());
+    pf_correction->setObservationModel(std::unique_ptr<FixedObservationModel<4, 2>>(new FixedLinearSensor()));
+
+
+    std::cout << "Constructing fixed-size SIS particle filter..." << std::flush;
+    TrackingSIS sis_pf;
+    sis_pf.setPrediction(std::move(pf_prediction));
+    sis_pf.setCorrection(std::move(pf_correction));
+    sis_pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Running fixed-size SIS particle filter..." << std::flush;
+    sis_pf.boot();
+    sis_pf.run();
+    if (!sis_pf.wait())
+        return EXIT_FAILURE;
+    std::cout << "completed with average position error " << sis_pf.getError() << "!" << std::endl;
+
+    if (!(sis_pf.getError() < 15.0))
+        return EXIT_FAILURE;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <BayesFilters/KalmanFilter.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include "FilterTestUtils.h"
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/* Count the heap allocations made by the filtering steps. */
+std::atomic<bool>        count_allocations(false);
+std::atomic<std::size_t> num_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    if (count_allocations)
+        ++num_allocations;
+
+    if (void* ptr = std::malloc(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+class TestKalmanFilter : public KalmanFilter
+{
+public:
+    /* Textbook Kalman filter in double precision, starting from the first measurement. */
+    MatrixXd reference()
+    {
+        const MatrixXd H = H_.cast<double>();
+
+        return referenceKalmanFilter(F_.cast<double>(), H, Q_.cast<double>(), R_.cast<double>(),
+                                     measurement_.cast<double>(), H.transpose() * measurement_.col(0).cast<double>());
+    }
+
+    MatrixXf getStates() { return result_x_; }
+
+    MatrixXf getObject() { return object_; }
+
+    MatrixXf getMeasurements() { return measurement_; }
+
+protected:
+    void filteringStep() override
+    {
+        count_allocations = true;
+        KalmanFilter::filteringStep();
+        count_allocations = false;
+    }
+};
+
+
+int main()
+{
+    MatrixXf F(4, 4);
+    F << 1.0, 1.0, 0.0, 0.0,
+         0.0, 1.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 1.0,
+         0.0, 0.0, 0.0, 1.0;
+
+    MatrixXf H(2, 4);
+    H << 1.0, 0.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 0.0;
+
+
+    std::cout << "Constructing Kalman filter..." << std::flush;
+    TestKalmanFilter kf;
+    kf.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F);
+    kf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Running Kalman filter..." << std::flush;
+    kf.boot();
+    kf.run();
+    if (!kf.wait())
+        return EXIT_FAILURE;
+    std::cout << "completed!" << std::endl;
+
+
+    std::cout << "Heap allocations during the filtering steps: " << num_allocations << std::endl;
+    if (num_allocations != 0)
+        return EXIT_FAILURE;
+
+    const double error = (kf.getStates().cast<double>() - kf.reference()).cwiseAbs().maxCoeff();
+    std::cout << "Maximum difference from the reference implementation: " << error << std::endl;
+    if (error > 1e-2)
+        return EXIT_FAILURE;
+
+    /* The filter tracks the position more closely than the raw measurements. */
+    const double tracking_error    = trackingError(kf.getStates().row(0), kf.getObject().row(0));
+    const double measurement_error = trackingError(kf.getMeasurements().row(0), kf.getObject().row(0));
+    std::cout << "Average x error: " << tracking_error << ", measurement " << measurement_error << std::endl;
+    if (!(tracking_error < measurement_error))
+        return EXIT_FAILURE;
+
+
+    std::cout << "Running Kalman filter step by step on the same measurements..." << std::flush;
+    {
+        TestKalmanFilter inline_kf;
+        inline_kf.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F);
+        inline_kf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+
+        const MatrixXf measurements = kf.getMeasurements();
+
+        MatrixXf states(4, measurements.cols());
+        for (int k = 0; k < measurements.cols(); ++k)
+            states.col(k) = inline_kf.step(measurements.col(k));
+
+        /* Measurement-driven steps are not bounded by the simulation length. */
+        inline_kf.step(measurements.col(measurements.cols() - 1));
+        if (!inline_kf.step() || inline_kf.getFilteringStep() != measurements.cols() + 2)
+        {
+            std::cerr << "failed, measurement-driven steps bounded by the simulation!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if ((states - kf.getStates()).cwiseAbs().maxCoeff() > 1e-6)
+        {
+            std::cerr << "failed, results differ from the threaded filter!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* After a reset the filter initializes again. */
+        inline_kf.reset();
+        if ((inline_kf.step(measurements.col(0)) - states.col(0)).cwiseAbs().maxCoeff() > 1e-6 || inline_kf.getFilteringStep() != 1)
+        {
+            std::cerr << "failed, wrong first step after reset!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Moving Kalman filter..." << std::flush;
+    {
+        const MatrixXf states = kf.getStates();
+        const MatrixXf measurements = kf.getMeasurements();
+
+        TestKalmanFilter moved_kf(std::move(kf));
+        if (moved_kf.getStates() != states || moved_kf.getMeasurements() != measurements)
+        {
+            std::cerr << "failed, results are not moved!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
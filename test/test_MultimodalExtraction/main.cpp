@@ -0,0 +1,115 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <BayesFilters/MultimodalExtraction.h>
+#include <BayesFilters/ThreadPool.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+int main()
+{
+    /* Two clusters of particles with state (x, x_dot, y, y_dot), clustered on the positions only. */
+    const int num_particles = 10000;
+    const Vector4f center_a(0.0f,  1.0f, 0.0f, -1.0f);
+    const Vector4f center_b(5.0f, -2.0f, 3.0f,  0.5f);
+
+    std::mt19937_64 generator(1);
+    std::normal_distribution<float> normal(0.0f, 0.3f);
+    std::uniform_real_distribution<float> uniform(0.5f, 1.5f);
+
+    MatrixXf particles(4, num_particles);
+    VectorXf weights(num_particles);
+    for (int j = 0; j < num_particles; ++j)
+    {
+        particles.col(j) = (j % 2 == 0) ? center_a : center_b;
+        for (int i = 0; i < 4; ++i)
+            particles(i, j) += normal(generator);
+
+        /* Cluster a carries about 70% of the weight. */
+        weights(j) = uniform(generator) * ((j % 2 == 0) ? 0.7f : 0.3f);
+    }
+
+    Vector4f mean_a = Vector4f::Zero();
+    Vector4f mean_b = Vector4f::Zero();
+    float mass_a = 0.0f;
+    float mass_b = 0.0f;
+    for (int j = 0; j < num_particles; ++j)
+    {
+        if (j % 2 == 0)
+        {
+            mean_a += weights(j) * particles.col(j);
+            mass_a += weights(j);
+        }
+        else
+        {
+            mean_b += weights(j) * particles.col(j);
+            mass_b += weights(j);
+        }
+    }
+    mean_a /= mass_a;
+    mean_b /= mass_b;
+    mass_a /= weights.sum();
+    mass_b = 1.0f - mass_a;
+
+    const Vector4f bandwidth(1.0f, 0.0f, 1.0f, 0.0f);
+
+
+    std::cout << "Checking the two heaviest modes..." << std::flush;
+    MatrixXf modes;
+    {
+        MultimodalExtraction multimodal_extraction(bandwidth, 2);
+
+        const unsigned int num_modes = multimodal_extraction.extract(particles, weights);
+        if (num_modes != 2)
+        {
+            std::cerr << "failed, found " << num_modes << " modes!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        modes = multimodal_extraction.getModes();
+        const VectorXf& masses = multimodal_extraction.getMasses();
+
+        const float mode_error = std::max((modes.col(0) - mean_a).cwiseAbs().maxCoeff(), (modes.col(1) - mean_b).cwiseAbs().maxCoeff());
+        const float mass_error = std::max(std::abs(masses(0) - mass_a), std::abs(masses(1) - mass_b));
+        if (mode_error > 0.05 || mass_error > 0.01)
+        {
+            std::cerr << "failed, mode error " << mode_error << ", mass error " << mass_error << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking the heaviest mode only..." << std::flush;
+    {
+        MultimodalExtraction multimodal_extraction(bandwidth, 1);
+
+        if (multimodal_extraction.extract(particles, weights) != 1 || (multimodal_extraction.getModes().col(0) - modes.col(0)).cwiseAbs().maxCoeff() > 1e-6)
+        {
+            std::cerr << "failed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking extraction on a thread pool..." << std::flush;
+    {
+        MultimodalExtraction multimodal_extraction(bandwidth, 2);
+        multimodal_extraction.setThreadPool(std::make_shared<ThreadPool>(4));
+
+        if (multimodal_extraction.extract(particles, weights) != 2 || (multimodal_extraction.getModes() - modes).cwiseAbs().maxCoeff() > 1e-6)
+        {
+            std::cerr << "failed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -1,5 +1,7 @@
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <thread>
 
 #include <BayesFilters/ParticleFilter.h>
@@ -9,6 +11,10 @@ using namespace bfl;
 
 class DummyParticleFilter : public ParticleFilter
 {
+public:
+    using ParticleFilter::normalizeWeights;
+
+private:
     void initialization() { std::cout << "Invoked DummyParticleFilter::initialization()." << std::endl; };
 
     void filteringStep() { std::cout << "Invoked DummyParticleFilter::filteringStep(): step " << getFilteringStep() << "." << std::endl; };
@@ -74,5 +80,34 @@ int main()
     std::cout << "done!" << std::endl;
 
 
+    std::cout << "Normalizing vanishing weights..." << std::flush;
+    Eigen::VectorXf weights(4);
+    weights << 0.0f, 0.0f, 3.0f, 1.0f;
+    WeightStatistics statistics = dummy.normalizeWeights(weights);
+    if (!std::isfinite(statistics.entropy) || std::abs(weights.sum() - 1.0f) > 1e-6f)
+    {
+        std::cerr << "Entropy of zero linear weights is not finite." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    dummy.setLogWeights(true);
+    weights << -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.0f, -1.0f;
+    statistics = dummy.normalizeWeights(weights);
+    if (!std::isfinite(statistics.entropy) || std::abs(weights.array().exp().sum() - 1.0f) > 1e-6f)
+    {
+        std::cerr << "Entropy of -inf log-weights is not finite." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    weights.setConstant(-std::numeric_limits<float>::infinity());
+    statistics = dummy.normalizeWeights(weights);
+    if (!weights.allFinite() || std::abs(statistics.ess - 4.0) > 1e-6)
+    {
+        std::cerr << "All -inf log-weights are not set to uniform weights." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "done!" << std::endl;
+
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/Philox.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/* Known-answer vectors of Philox4x32-10 from the Random123 distribution (kat_vectors). */
+struct KnownAnswer
+{
+    std::uint32_t counter[4];
+    std::uint32_t key[2];
+    std::uint32_t output[4];
+};
+
+
+int main()
+{
+    std::cout << "Checking Philox4x32-10 against the Random123 known-answer vectors..." << std::flush;
+    const KnownAnswer known_answers[] =
+    {
+        { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 }, { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+        { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }, { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+        { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }, { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+    };
+
+    for (const KnownAnswer& known_answer : known_answers)
+    {
+        const Philox philox((static_cast<std::uint64_t>(known_answer.key[1]) << 32) | known_answer.key[0]);
+
+        std::uint32_t output[4];
+        philox.generate((static_cast<std::uint64_t>(known_answer.counter[1]) << 32) | known_answer.counter[0],
+                        (static_cast<std::uint64_t>(known_answer.counter[3]) << 32) | known_answer.counter[2],
+                        output);
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            if (output[i] != known_answer.output[i])
+            {
+                std::cerr << "failed, output " << i << " is " << std::hex << output[i] << " instead of " << known_answer.output[i] << "!" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking that resetting the noise restarts the keyed predictions..." << std::flush;
+    {
+        DrawParticles prediction;
+        prediction.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()));
+
+        const MatrixXf prev_states = MatrixXf::Zero(4, 100);
+        const VectorXf prev_weights = VectorXf::Constant(100, 0.01f);
+
+        MatrixXf first_states(4, 100);
+        MatrixXf second_states(4, 100);
+        VectorXf pred_weights(100);
+
+        prediction.predict(prev_states, prev_weights, first_states, pred_weights);
+        prediction.predict(prev_states, prev_weights, second_states, pred_weights);
+        if (second_states == first_states)
+        {
+            std::cerr << "failed, consecutive predictions draw the same noise!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        prediction.resetNoise();
+        prediction.predict(prev_states, prev_weights, second_states, pred_weights);
+        if (second_states != first_states)
+        {
+            std::cerr << "failed, the first prediction after the reset differs!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/RBPF.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include "FilterTestUtils.h"
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class TestRBPF : public RBPF
+{
+public:
+    /* Textbook Kalman filter in double precision, i.e. the exact posterior mean. */
+    MatrixXd reference(const Ref<const MatrixXd>& F, const Ref<const MatrixXd>& H)
+    {
+        const MatrixXd Q = state_model_->getNoiseCovarianceMatrix().cast<double>();
+        const MatrixXd R = observation_model_->getNoiseCovarianceMatrix().cast<double>();
+
+        return referenceKalmanFilter(F, H, Q, R, measurement_.cast<double>(), H.transpose() * measurement_.col(0).cast<double>());
+    }
+
+    MatrixXf getStates() { return result_state_; }
+
+    MatrixXf getObject() { return object_; }
+
+    MatrixXf getMeasurements() { return measurement_; }
+};
+
+
+int main()
+{
+    MatrixXf F(4, 4);
+    F << 1.0, 1.0, 0.0, 0.0,
+         0.0, 1.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 1.0,
+         0.0, 0.0, 0.0, 1.0;
+
+    MatrixXf H(2, 4);
+    H << 1.0, 0.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 0.0;
+
+
+    std::cout << "Constructing Rao-Blackwellized particle filter..." << std::flush;
+    TestRBPF rbpf;
+    rbpf.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F);
+    rbpf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+    rbpf.setLinearStates({1, 3});
+    rbpf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Running Rao-Blackwellized particle filter..." << std::flush;
+    rbpf.boot();
+    rbpf.run();
+    if (!rbpf.wait())
+        return EXIT_FAILURE;
+    std::cout << "completed!" << std::endl;
+
+
+    /* The sampled positions converge to the exact posterior, hence so do the marginalized velocities. */
+    const MatrixXd reference = rbpf.reference(F.cast<double>(), H.cast<double>());
+    const MatrixXd difference = (rbpf.getStates().cast<double>() - reference).rightCols(50);
+
+    const double position_difference = (difference.row(0).cwiseAbs().mean() + difference.row(2).cwiseAbs().mean()) / 2.0;
+    const double velocity_difference = (difference.row(1).cwiseAbs().mean() + difference.row(3).cwiseAbs().mean()) / 2.0;
+    std::cout << "Average difference from the Kalman filter: position " << position_difference << ", velocity " << velocity_difference << std::endl;
+
+    /* The filter tracks the position more closely than the raw measurements. */
+    const double tracking_error    = trackingError(rbpf.getStates().row(0), rbpf.getObject().row(0));
+    const double measurement_error = trackingError(rbpf.getMeasurements().row(0), rbpf.getObject().row(0));
+    std::cout << "Average x error: " << tracking_error << ", measurement " << measurement_error << std::endl;
+    if (!(tracking_error < measurement_error))
+        return EXIT_FAILURE;
+
+    if (!(position_difference < 1.0 && velocity_difference < 0.5))
+        return EXIT_FAILURE;
+
+
+    std::cout << "Stepping Rao-Blackwellized particle filter with the same measurements..." << std::flush;
+    TestRBPF inline_rbpf;
+    inline_rbpf.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()), F);
+    inline_rbpf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()), H);
+    inline_rbpf.setLinearStates({1, 3});
+    inline_rbpf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+
+    const MatrixXf measurements = rbpf.getMeasurements();
+    MatrixXf states(F.rows(), measurements.cols());
+    for (int k = 0; k < measurements.cols(); ++k)
+        states.col(k) = inline_rbpf.step(measurements.col(k));
+
+    if ((states - rbpf.getStates()).cwiseAbs().maxCoeff() > 1e-3)
+    {
+        std::cerr << "failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
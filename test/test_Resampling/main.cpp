@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <BayesFilters/MetropolisResampling.h>
+#include <BayesFilters/MultinomialResampling.h>
+#include <BayesFilters/RejectionResampling.h>
+#include <BayesFilters/Initialization.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/ResamplingWithPrior.h>
+#include <BayesFilters/ResidualResampling.h>
+#include <BayesFilters/StratifiedResampling.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+bool check_ancestors(const std::string& name, Resampling& resampling, const VectorXf& weights, const bool log_weights)
+{
+    const std::size_t num_particles = weights.size();
+    const std::size_t num_draws     = 200;
+
+    resampling.setLogWeights(log_weights);
+
+    VectorXf cor_weights = weights;
+    if (log_weights)
+        cor_weights = weights.array().log();
+
+    VectorXd counts = VectorXd::Zero(num_particles);
+    VectorXl ancestors(num_particles);
+
+    for (std::size_t n = 0; n < num_draws; ++n)
+    {
+        resampling.ancestors(cor_weights, ancestors);
+
+        for (std::size_t j = 0; j < num_particles; ++j)
+        {
+            if (ancestors(j) < 0 || ancestors(j) >= static_cast<std::int64_t>(num_particles))
+            {
+                std::cerr << name << ": ancestor " << ancestors(j) << " out of range." << std::endl;
+                return false;
+            }
+
+            counts(ancestors(j)) += 1.0;
+        }
+    }
+
+    /* The mean number of offspring of each particle must be M * w_i. */
+    const VectorXd expected = num_draws * num_particles * weights.cast<double>() / weights.cast<double>().sum();
+    const double   error    = ((counts - expected).array().abs() / (expected.array() + num_draws)).maxCoeff();
+
+    std::cout << name << (log_weights ? " (log weights)" : "") << ": maximum relative error on the offspring mean " << error << std::endl;
+
+    return error < 0.15;
+}
+
+
+class ConstantInitialization : public Initialization
+{
+public:
+    void initialize(Ref<MatrixXf> states, Ref<VectorXf> weights) override
+    {
+        states.setConstant(-1.0f);
+        weights.setConstant(1.0f / states.cols());
+    }
+};
+
+
+int main()
+{
+    const std::size_t num_particles = 100;
+
+    VectorXf weights(num_particles);
+    for (std::size_t i = 0; i < num_particles; ++i)
+        weights(i) = std::exp(-0.5f * std::pow((static_cast<float>(i) - 30.0f) / 10.0f, 2.0f)) + 0.01f;
+
+
+    std::unique_ptr<MetropolisResampling> metropolis(new MetropolisResampling(1));
+    metropolis->setNumIterations(64);
+
+    std::vector<std::pair<std::string, std::unique_ptr<Resampling>>> schemes;
+    schemes.emplace_back("Systematic",  std::unique_ptr<Resampling>(new Resampling(1)));
+    schemes.emplace_back("Multinomial", std::unique_ptr<Resampling>(new MultinomialResampling(1)));
+    schemes.emplace_back("Stratified",  std::unique_ptr<Resampling>(new StratifiedResampling(1)));
+    schemes.emplace_back("Residual",    std::unique_ptr<Resampling>(new ResidualResampling(1)));
+    schemes.emplace_back("Metropolis",  std::move(metropolis));
+    schemes.emplace_back("Rejection",   std::unique_ptr<Resampling>(new RejectionResampling(1)));
+
+    for (auto& scheme : schemes)
+    {
+        if (!check_ancestors(scheme.first, *scheme.second, weights, false))
+            return EXIT_FAILURE;
+
+        if (!check_ancestors(scheme.first, *scheme.second, weights, true))
+            return EXIT_FAILURE;
+    }
+
+
+    std::cout << "Resampling 4 particles into 10 with the stratified scheme..." << std::flush;
+    StratifiedResampling stratified(1);
+
+    MatrixXf pred_particles = MatrixXf::Random(2, 4);
+    VectorXf pred_weights(4);
+    pred_weights << 0.1f, 0.2f, 0.3f, 0.4f;
+
+    MatrixXf res_particles(2, 10);
+    VectorXf res_weights(10);
+    VectorXf res_parents(10);
+    stratified.resample(pred_particles, pred_weights, res_particles, res_weights, res_parents);
+
+    for (std::size_t j = 0; j < 10; ++j)
+    {
+        if (!res_particles.col(j).isApprox(pred_particles.col(static_cast<std::size_t>(res_parents(j)))))
+        {
+            std::cerr << "failed, particle " << j << " is not a copy of its parent." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Resampling 10 particles with prior..." << std::flush;
+    ResamplingWithPrior resampling_prior(std::unique_ptr<Initialization>(new ConstantInitialization()), 0.3, 1);
+
+    MatrixXf cor_particles(1, 10);
+    cor_particles << 0, 1, 2, 3, 4, 5, 6, 7, 8, 9;
+    VectorXf cor_weights(10);
+    cor_weights << 0.2f, 0.01f, 0.2f, 0.02f, 0.2f, 0.03f, 0.2f, 0.04f, 0.1f, 0.0f;
+
+    MatrixXf prior_particles(1, 10);
+    VectorXf prior_weights(10);
+    VectorXf prior_parents(10);
+    resampling_prior.resample(cor_particles, cor_weights, prior_particles, prior_weights, prior_parents);
+
+    for (std::size_t j = 0; j < 10; ++j)
+    {
+        const bool from_prior = j < 3;
+        const bool low_weight = prior_parents(j) == 1 || prior_parents(j) == 3 || prior_parents(j) == 9;
+
+        if (( from_prior && (prior_parents(j) != -1 || prior_particles(j) != -1.0f)) ||
+            (!from_prior && (low_weight || prior_particles(j) != prior_parents(j))))
+        {
+            std::cerr << "failed, wrong particle " << j << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,17 @@
 #include <BayesFilters/WhiteNoiseAcceleration.h>
 
 using namespace bfl;
+using namespace Eigen;
+
+
+class TestSIS : public SIS
+{
+public:
+    MatrixXf getMeasurements() { return measurement_; }
+
+    /* Weighted mean of the corrected particles of step k, before resampling. */
+    VectorXf getEstimate(const unsigned int k) { return result_cor_particle_[k] * result_cor_weight_[k]; }
+};
 
 
 int main()
@@ -34,7 +45,7 @@ int main()
 
 
     std::cout << "Constructing SIS particle filter..." << std::flush;
-    SIS sis_pf;
+    TestSIS sis_pf;
     sis_pf.setPrediction(std::move(pf_prediction));
     sis_pf.setCorrection(std::move(pf_correction));
     sis_pf.setResampling(std::move(resampling));
@@ -59,5 +70,41 @@ int main()
     std::cout << "done!" << std::endl;
 
 
+    std::cout << "Running SIS particle filter step by step on the same measurements..." << std::flush;
+    {
+        std::unique_ptr<DrawParticles> inline_prediction(new DrawParticles());
+        inline_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+
+        std::unique_ptr<UpdateParticles> inline_correction(new UpdateParticles());
+        inline_correction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor()));
+
+        SIS inline_pf;
+        inline_pf.setPrediction(std::move(inline_prediction));
+        inline_pf.setCorrection(std::move(inline_correction));
+        inline_pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+
+        const MatrixXf measurements = sis_pf.getMeasurements();
+        for (int k = 0; k < measurements.cols(); ++k)
+        {
+            const VectorXf estimate = inline_pf.step(measurements.col(k));
+
+            if ((estimate - sis_pf.getEstimate(k)).cwiseAbs().maxCoeff() > 1e-3)
+            {
+                std::cerr << "failed at step " << k << "!" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* Measurement-driven steps are not bounded by the simulation length. */
+        inline_pf.step(measurements.col(measurements.cols() - 1));
+        if (inline_pf.getFilteringStep() != measurements.cols() + 1)
+        {
+            std::cerr << "failed, measurement-driven steps bounded by the simulation!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/GaussianProposalPrediction.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/UpdateParticles.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include "FilterTestUtils.h"
+
+using namespace bfl;
+using namespace Eigen;
+
+
+double run_sis(std::unique_ptr<PFPrediction> pf_prediction, const int num_particles, const unsigned int num_threads)
+{
+    std::unique_ptr<UpdateParticles> pf_correction(new UpdateParticles());
+    pf_correction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor(1.0f, 1.0f)));
+
+    Estimates<SIS> sis_pf(num_particles);
+    sis_pf.setPrediction(std::move(pf_prediction));
+    sis_pf.setCorrection(std::move(pf_correction));
+    sis_pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    sis_pf.setNumThreads(num_threads);
+    sis_pf.setLogWeights(true);
+
+    sis_pf.boot();
+    sis_pf.run();
+    sis_pf.wait();
+
+    return sis_pf.getError();
+}
+
+
+int main()
+{
+    std::cout << "Running SIS particle filter with the transition prior and 900 particles..." << std::flush;
+    std::unique_ptr<DrawParticles> prior_prediction(new DrawParticles());
+    prior_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+    const double prior_error = run_sis(std::move(prior_prediction), 900, 1);
+    std::cout << "position error " << prior_error << std::endl;
+
+
+    std::cout << "Running SIS particle filter with the Gaussian proposal and 100 particles..." << std::flush;
+    std::unique_ptr<GaussianProposalPrediction> proposal_prediction(new GaussianProposalPrediction());
+    proposal_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+    proposal_prediction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor(1.0f, 1.0f)));
+    const double proposal_error = run_sis(std::move(proposal_prediction), 100, 1);
+    std::cout << "position error " << proposal_error << std::endl;
+
+
+    std::cout << "Running SIS particle filter with the Gaussian proposal and 100 particles on 4 threads..." << std::flush;
+    std::unique_ptr<GaussianProposalPrediction> parallel_prediction(new GaussianProposalPrediction());
+    parallel_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+    parallel_prediction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor(1.0f, 1.0f)));
+    const double parallel_error = run_sis(std::move(parallel_prediction), 100, 4);
+    std::cout << "position error " << parallel_error << std::endl;
+
+    if (!(proposal_error <= prior_error) || parallel_error != proposal_error)
+        return EXIT_FAILURE;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/KLDSampling.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/UpdateParticles.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+int main()
+{
+    std::cout << "Checking KLD-sampling bounds..." << std::flush;
+    VectorXf bin_size(4);
+    bin_size << 10.0f, 0.0f, 10.0f, 0.0f;
+
+    KLDSampling kld_sampling(bin_size, 0.05, 0.01, 100, 5000);
+    if (kld_sampling.numParticles(1) != 100 || kld_sampling.numParticles(100000) != 5000 ||
+        kld_sampling.numParticles(50) >= kld_sampling.numParticles(200))
+    {
+        std::cerr << "failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* Out of range epsilon and delta are clamped: the former to a tiny positive value, the latter to (0, 0.5]. */
+    KLDSampling kld_zero(bin_size, 0.0, 0.0, 100, 5000);
+    KLDSampling kld_half(bin_size, 0.05, 0.5, 100, 5000);
+    KLDSampling kld_one(bin_size, 0.05, 1.0, 100, 5000);
+    if (kld_zero.numParticles(50) != 5000 || kld_one.numParticles(200) != kld_half.numParticles(200))
+    {
+        std::cerr << "failed, out of range parameters not clamped!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    MatrixXf particles = MatrixXf::Zero(4, 10);
+    for (int j = 0; j < 10; ++j)
+        particles.col(j) << 10.0f * j + 5.0f, 1.0f, 5.0f, -1.0f;
+    particles.col(9) = particles.col(8);
+
+    if (kld_sampling.countBins(particles) != 9)
+    {
+        std::cerr << "failed, wrong number of occupied bins!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::unique_ptr<DrawParticles> pf_prediction(new DrawParticles());
+    pf_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+
+    std::unique_ptr<UpdateParticles> pf_correction(new UpdateParticles());
+    pf_correction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor()));
+
+
+    std::cout << "Constructing SIS particle filter with KLD-sampling..." << std::flush;
+    SIS sis_pf;
+    sis_pf.setPrediction(std::move(pf_prediction));
+    sis_pf.setCorrection(std::move(pf_correction));
+    sis_pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    sis_pf.setKLDSampling(std::unique_ptr<KLDSampling>(new KLDSampling(bin_size, 0.05, 0.01, 100, 5000)));
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Running SIS particle filter..." << std::flush;
+    sis_pf.boot();
+    sis_pf.run();
+    if (!sis_pf.wait())
+        return EXIT_FAILURE;
+    std::cout << "completed with " << sis_pf.getNumParticles() << " particles!" << std::endl;
+
+
+    std::cout << "Checking that the number of particles adapts..." << std::flush;
+    {
+        /* The initial grid of particles covers the whole surveillance area and
+         * occupies many bins, once the track is localized few bins remain. */
+        sis_pf.reset();
+
+        sis_pf.step();
+        const int initial_particles = sis_pf.getNumParticles();
+
+        for (int k = 1; k < 50; ++k)
+            sis_pf.step();
+        const int localized_particles = sis_pf.getNumParticles();
+
+        std::cout << " " << initial_particles << " -> " << localized_particles << " particles..." << std::flush;
+        if (localized_particles >= initial_particles / 2)
+        {
+            std::cerr << "failed, the number of particles did not drop!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* A new KLDSampling set between steps is used from the next one. */
+        sis_pf.setKLDSampling(std::unique_ptr<KLDSampling>(new KLDSampling(bin_size, 0.05, 0.01, 2000, 5000)));
+        sis_pf.step();
+        sis_pf.step();
+        if (sis_pf.getNumParticles() < 2000)
+        {
+            std::cerr << "failed, the new KLDSampling was not used!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/UpdateParticles.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class SISParticles : public SIS
+{
+public:
+    Eigen::MatrixXf getParticles() { return cor_particle_; }
+
+protected:
+    void initialization() override
+    {
+        SIS::initialization();
+
+        /* Use enough particles to have several blocks per thread. */
+        setNumParticles(20000);
+    }
+};
+
+
+MatrixXf run_sis(const unsigned int num_threads)
+{
+    std::unique_ptr<DrawParticles> pf_prediction(new DrawParticles());
+    pf_prediction->setStateModel(std::unique_ptr<WhiteNoiseAcceleration>(new WhiteNoiseAcceleration()));
+
+    std::unique_ptr<UpdateParticles> pf_correction(new UpdateParticles());
+    pf_correction->setObservationModel(std::unique_ptr<LinearSensor>(new LinearSensor()));
+
+    SISParticles sis_pf;
+    sis_pf.setPrediction(std::move(pf_prediction));
+    sis_pf.setCorrection(std::move(pf_correction));
+    sis_pf.setResampling(std::unique_ptr<Resampling>(new Resampling()));
+    sis_pf.setNumThreads(num_threads);
+
+    sis_pf.boot();
+    sis_pf.run();
+    sis_pf.wait();
+
+    return sis_pf.getParticles();
+}
+
+
+int main()
+{
+    std::cout << "Running SIS particle filter on 1 thread..." << std::flush;
+    const MatrixXf particles_serial = run_sis(1);
+    std::cout << "done!" << std::endl;
+
+    std::cout << "Running SIS particle filter on 4 threads..." << std::flush;
+    const MatrixXf particles_parallel = run_sis(4);
+    std::cout << "done!" << std::endl;
+
+    if (particles_serial.cols() != 20000 || particles_serial != particles_parallel)
+    {
+        std::cerr << "The particles depend on the number of threads!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+
+    return EXIT_SUCCESS;
+}
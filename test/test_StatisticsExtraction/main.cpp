@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <BayesFilters/StatisticsExtraction.h>
+#include <BayesFilters/ThreadPool.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/* Smallest value whose cumulative weight reaches probability, by sorting. */
+float sorted_quantile(const Ref<const RowVectorXf>& values, const Ref<const VectorXf>& weights, const double probability)
+{
+    std::vector<std::pair<float, double>> sorted;
+    for (int j = 0; j < values.size(); ++j)
+        sorted.emplace_back(values(j), weights(j));
+    std::sort(sorted.begin(), sorted.end());
+
+    const double target = probability * weights.cast<double>().sum();
+
+    double cumulative = 0.0;
+    for (const auto& element : sorted)
+    {
+        cumulative += element.second;
+        if (cumulative >= target)
+            return element.first;
+    }
+
+    return sorted.back().first;
+}
+
+
+int main()
+{
+    const int num_particles = 5000;
+
+    /* Particles far from the origin, with repeated values in the last component. */
+    MatrixXf particles = MatrixXf::Random(3, num_particles);
+    particles.row(0) = particles.row(0) * 2.0f + RowVectorXf::Constant(num_particles, 1000.0f);
+    particles.row(2) = (particles.row(2) * 5.0f).array().round();
+
+    VectorXf weights = VectorXf::Random(num_particles).cwiseAbs();
+
+    const std::vector<double> probabilities = {0.5, 0.0, 0.9, 1.0, 0.25};
+
+
+    std::cout << "Checking mean and covariance..." << std::flush;
+    StatisticsExtraction statistics_extraction;
+    statistics_extraction.setMethod(StatisticsExtraction::ExtractionMethod::full);
+    statistics_extraction.setQuantiles(probabilities);
+    statistics_extraction.setCredibleLevel(0.9);
+    statistics_extraction.extract(particles, weights);
+    {
+        const MatrixXd particles_d = particles.cast<double>();
+        const VectorXd weights_d = weights.cast<double>() / weights.cast<double>().sum();
+
+        const VectorXd mean = particles_d * weights_d;
+        const MatrixXd deviations = particles_d.colwise() - mean;
+        const MatrixXd covariance = deviations * weights_d.asDiagonal() * deviations.transpose();
+
+        const double mean_error = (statistics_extraction.getMean().cast<double>() - mean).cwiseAbs().maxCoeff();
+        const double covariance_error = (statistics_extraction.getCovariance().cast<double>() - covariance).cwiseAbs().maxCoeff();
+        if (mean_error > 1e-3 || covariance_error > 1e-4)
+        {
+            std::cerr << "failed, mean error " << mean_error << ", covariance error " << covariance_error << "!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking quantiles and credible intervals against sorting..." << std::flush;
+    {
+        const MatrixXf& quantiles = statistics_extraction.getQuantiles();
+        const MatrixXf& credible_intervals = statistics_extraction.getCredibleIntervals();
+
+        if (quantiles.rows() != 3 || quantiles.cols() != static_cast<int>(probabilities.size()) || credible_intervals.cols() != 2)
+        {
+            std::cerr << "failed, wrong sizes!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (std::size_t k = 0; k < probabilities.size(); ++k)
+            {
+                if (quantiles(i, k) != sorted_quantile(particles.row(i), weights, probabilities[k]))
+                {
+                    std::cerr << "failed, quantile " << probabilities[k] << " of component " << i << "!" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+
+            if (credible_intervals(i, 0) != sorted_quantile(particles.row(i), weights, 0.05) ||
+                credible_intervals(i, 1) != sorted_quantile(particles.row(i), weights, 0.95))
+            {
+                std::cerr << "failed, credible interval of component " << i << "!" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking extraction on a thread pool..." << std::flush;
+    {
+        StatisticsExtraction parallel_extraction;
+        parallel_extraction.setMethod(StatisticsExtraction::ExtractionMethod::full);
+        parallel_extraction.setQuantiles(probabilities);
+        parallel_extraction.setCredibleLevel(0.9);
+        parallel_extraction.setThreadPool(std::make_shared<ThreadPool>(4));
+        parallel_extraction.extract(particles, weights);
+
+        if (parallel_extraction.getMean() != statistics_extraction.getMean() ||
+            parallel_extraction.getCovariance() != statistics_extraction.getCovariance() ||
+            parallel_extraction.getQuantiles() != statistics_extraction.getQuantiles() ||
+            parallel_extraction.getCredibleIntervals() != statistics_extraction.getCredibleIntervals())
+        {
+            std::cerr << "failed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    std::cout << "Checking the mean-only method..." << std::flush;
+    {
+        StatisticsExtraction mean_extraction;
+        mean_extraction.setMethod(StatisticsExtraction::ExtractionMethod::mean);
+        mean_extraction.extract(particles, weights);
+
+        if (mean_extraction.getMean() != statistics_extraction.getMean() || mean_extraction.getCovariance().size() != 0 || mean_extraction.getQuantiles().size() != 0)
+        {
+            std::cerr << "failed!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "done!" << std::endl;
+
+
+    return EXIT_SUCCESS;
+}
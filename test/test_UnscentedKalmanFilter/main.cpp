@@ -0,0 +1,164 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include <BayesFilters/LinearSensor.h>
+#include <BayesFilters/SigmaPointTransform.h>
+#include <BayesFilters/UnscentedKalmanFilter.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include "FilterTestUtils.h"
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/* Count the batched calls to propagate(). */
+class CountingWNA : public WhiteNoiseAcceleration
+{
+public:
+    void propagate(const Ref<const MatrixXf>& cur_states, Ref<MatrixXf> prop_states) override
+    {
+        ++num_propagate;
+        WhiteNoiseAcceleration::propagate(cur_states, prop_states);
+    }
+
+    unsigned int num_propagate = 0;
+};
+
+
+class TestUnscentedKalmanFilter : public UnscentedKalmanFilter
+{
+public:
+    /* Textbook Kalman filter in double precision, starting from a zero state. */
+    MatrixXd reference(const Ref<const MatrixXd>& F, const Ref<const MatrixXd>& H)
+    {
+        return referenceKalmanFilter(F, H, Q_.cast<double>(), R_.cast<double>(),
+                                     measurement_.cast<double>(), VectorXd::Zero(F.rows()));
+    }
+
+    MatrixXf getStates() { return result_x_; }
+
+    MatrixXf getObject() { return object_; }
+
+    MatrixXf getMeasurements() { return measurement_; }
+};
+
+
+/* Run a sigma-point filter on the linear models and compare it with the Kalman filter. */
+bool testFilter(const SigmaPointTransform::Type type, const std::string& name)
+{
+    MatrixXd F(4, 4);
+    F << 1.0, 1.0, 0.0, 0.0,
+         0.0, 1.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 1.0,
+         0.0, 0.0, 0.0, 1.0;
+
+    MatrixXd H(2, 4);
+    H << 1.0, 0.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 0.0;
+
+    std::cout << "Running " << name << " Kalman filter..." << std::flush;
+
+    CountingWNA* wna = new CountingWNA();
+
+    TestUnscentedKalmanFilter ukf;
+    ukf.setStateModel(std::unique_ptr<StateModel>(wna));
+    ukf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()));
+    ukf.setSigmaPointTransform(std::unique_ptr<SigmaPointTransform>(new SigmaPointTransform(4, type)));
+
+    ukf.boot();
+    ukf.run();
+    if (!ukf.wait())
+        return false;
+    std::cout << "completed!" << std::endl;
+
+    std::cout << "Calls to propagate(): " << wna->num_propagate << " in " << ukf.getFilteringStep() << " steps" << std::endl;
+    if (wna->num_propagate != ukf.getFilteringStep() - 1)
+        return false;
+
+    const MatrixXd reference = ukf.reference(F, H);
+    const double error = ((ukf.getStates().cast<double>() - reference).cwiseAbs().array() / (1.0 + reference.cwiseAbs().array())).maxCoeff();
+    std::cout << "Maximum relative difference from the Kalman filter: " << error << std::endl;
+    if (error > 1e-2)
+        return false;
+
+    /* The filter tracks the position more closely than the raw measurements. */
+    const double tracking_error    = trackingError(ukf.getStates().row(0), ukf.getObject().row(0));
+    const double measurement_error = trackingError(ukf.getMeasurements().row(0), ukf.getObject().row(0));
+    std::cout << "Average x error: " << tracking_error << ", measurement " << measurement_error << std::endl;
+    if (!(tracking_error < measurement_error))
+        return false;
+
+
+    std::cout << "Running " << name << " Kalman filter step by step on the same measurements..." << std::flush;
+    TestUnscentedKalmanFilter inline_ukf;
+    inline_ukf.setStateModel(std::unique_ptr<StateModel>(new WhiteNoiseAcceleration()));
+    inline_ukf.setObservationModel(std::unique_ptr<ObservationModel>(new LinearSensor()));
+    inline_ukf.setSigmaPointTransform(std::unique_ptr<SigmaPointTransform>(new SigmaPointTransform(4, type)));
+
+    const MatrixXf measurements = ukf.getMeasurements();
+
+    MatrixXf states(4, measurements.cols());
+    for (int k = 0; k < measurements.cols(); ++k)
+        states.col(k) = inline_ukf.step(measurements.col(k));
+
+    /* Measurement-driven steps are not bounded by the simulation length. */
+    if (!inline_ukf.step() || (states - ukf.getStates()).cwiseAbs().maxCoeff() > 1e-6)
+    {
+        std::cerr << "failed!" << std::endl;
+        return false;
+    }
+    std::cout << "done!" << std::endl;
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Checking moments of a linear map..." << std::endl;
+    {
+        MatrixXf A = MatrixXf::Random(3, 3);
+        MatrixXf L = MatrixXf::Random(3, 3);
+        VectorXf mean = VectorXf::Random(3);
+        MatrixXf cov = L * L.transpose() + MatrixXf::Identity(3, 3);
+
+        SigmaPointTransform transforms[] = { SigmaPointTransform(3, SigmaPointTransform::Type::unscented),
+                                             SigmaPointTransform(3, SigmaPointTransform::Type::cubature),
+                                             SigmaPointTransform(3, SigmaPointTransform::Type::gauss_hermite),
+                                             SigmaPointTransform(3, 0.5, 2.0, 1.0) };
+        const unsigned int num_points[] = { 7, 6, 27, 7 };
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            MatrixXf points(3, transforms[i].getNumSigmaPoints());
+            transforms[i].sigmaPoints(mean, cov, points);
+
+            const MatrixXf mapped = A * points;
+            VectorXf mapped_mean(3);
+            MatrixXf mapped_cov(3, 3);
+            MatrixXf deviations(3, points.cols());
+            transforms[i].moments(mapped, mapped_mean, mapped_cov, deviations);
+
+            const float mean_error = (mapped_mean - A * mean).cwiseAbs().maxCoeff();
+            const float cov_error  = (mapped_cov - A * cov * A.transpose()).cwiseAbs().maxCoeff();
+            std::cout << "\t" << transforms[i].getNumSigmaPoints() << " sigma points, mean error " << mean_error << ", covariance error " << cov_error << std::endl;
+
+            if (transforms[i].getNumSigmaPoints() != num_points[i] || mean_error > 1e-4 || cov_error > 1e-3)
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (!testFilter(SigmaPointTransform::Type::unscented, "unscented"))
+        return EXIT_FAILURE;
+
+    if (!testFilter(SigmaPointTransform::Type::cubature, "cubature"))
+        return EXIT_FAILURE;
+
+    if (!testFilter(SigmaPointTransform::Type::gauss_hermite, "Gauss-Hermite"))
+        return EXIT_FAILURE;
+
+
+    return EXIT_SUCCESS;
+}